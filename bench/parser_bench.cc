@@ -0,0 +1,106 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <compiler/ast/ast.h>
+#include <compiler/ast/parser.h>
+
+#include <compiler/io/source_buffer.h>
+
+#include <compiler/token/keyword_table.h>
+#include <compiler/token/token_stream.h>
+
+namespace {
+
+/// Spells `index` with letters, identifiers can not contain digits.
+std::string MakeName(std::size_t index) {
+  std::string name{"function_"};
+  do {
+    name.push_back(static_cast<char>('a' + index % 26));
+    index /= 26;
+  } while (index > 0);
+  return name;
+}
+
+/// Generates `function_count` functions in the spirit of test.txt.
+std::string MakeSource(std::size_t function_count) {
+  std::string source{};
+  for (std::size_t index = 0; index < function_count; ++index) {
+    source += "int " + MakeName(index) + "(int a, int b) {\n"
+              "  int sum = 0;\n"
+              "  int product = a * b + " + std::to_string(index) + ";\n"
+              "  if (a >= b && b < 10) {\n"
+              "    sum = a - b;\n"
+              "  } else {\n"
+              "    for (int i = 0; i < b; i++) {\n"
+              "      sum += i * (a + 1);\n"
+              "      product <<= 1;\n"
+              "    }\n"
+              "  }\n"
+              "  while (sum > 100) {\n"
+              "    sum /= 2;\n"
+              "  }\n"
+              "  return sum + product;\n"
+              "}\n";
+  }
+  return source;
+}
+
+void BM_Parse(benchmark::State& state) {
+  auto source = MakeSource(static_cast<std::size_t>(state.range(0)));
+  compiler::KeywordTable keyword_table{};
+
+  std::size_t node_count{};
+  std::size_t memory_usage{};
+  for (auto _ : state) {
+    compiler::SourceBuffer source_buffer{source};
+    compiler::TokenStream stream{compiler::GenerateTokens(source_buffer, keyword_table)};
+    compiler::Ast ast{};
+    compiler::Parser parser{stream, ast};
+    benchmark::DoNotOptimize(parser.ParseTranslationUnit());
+    node_count = ast.GetNodeCount();
+    memory_usage = ast.GetMemoryUsage();
+  }
+
+  constexpr double kMegabyte = 1024.0 * 1024.0;
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * source.size()));
+  state.counters["nodes"] = static_cast<double>(node_count);
+  state.counters["nodes_per_arena_MB"] = static_cast<double>(node_count) / (static_cast<double>(memory_usage) / kMegabyte);
+  state.counters["nodes_per_source_MB"] = static_cast<double>(node_count) / (static_cast<double>(source.size()) / kMegabyte);
+  state.counters["nodes_per_second"] = benchmark::Counter(static_cast<double>(node_count), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_Parse)->Arg(1)->Arg(64)->Arg(1024);
+
+/// Walks the whole tree through sibling links, the access pattern of later passes.
+void BM_Walk(benchmark::State& state) {
+  auto source = MakeSource(static_cast<std::size_t>(state.range(0)));
+  compiler::KeywordTable keyword_table{};
+  compiler::SourceBuffer source_buffer{source};
+  compiler::TokenStream stream{compiler::GenerateTokens(source_buffer, keyword_table)};
+  compiler::Ast ast{};
+  compiler::Parser parser{stream, ast};
+  auto root = parser.ParseTranslationUnit();
+
+  std::vector<compiler::NodeIndex> stack{};
+  stack.reserve(ast.GetNodeCount());
+  for (auto _ : state) {
+    std::size_t visited{};
+    stack.push_back(root);
+    while (!stack.empty()) {
+      const auto& node = ast.GetNode(stack.back());
+      stack.pop_back();
+      ++visited;
+      for (auto child = node.first_child; child != compiler::kNullNode; child = ast.GetNode(child).next_sibling) {
+        stack.push_back(child);
+      }
+    }
+    benchmark::DoNotOptimize(visited);
+  }
+  state.counters["nodes_per_second"] = benchmark::Counter(static_cast<double>(ast.GetNodeCount()), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_Walk)->Arg(64)->Arg(1024);
+
+}  // namespace
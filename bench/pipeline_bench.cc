@@ -0,0 +1,95 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <compiler/io/source_buffer.h>
+
+#include <compiler/token/keyword_table.h>
+#include <compiler/token/pipelined_tokenizer.h>
+#include <compiler/token/token_writer.h>
+#include <compiler/token/tokenizer.h>
+
+namespace {
+
+std::string MakeSource(std::size_t repetitions) {
+  std::ifstream stream{COMPILER_INPUT};
+  std::string unit{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+  std::string source{};
+  for (std::size_t index = 0; index < repetitions; ++index) {
+    source += unit;
+  }
+  return source;
+}
+
+/// Lexes and emits tokens in lockstep on one thread, as `main` does by default.
+void BM_Serial(benchmark::State& state) {
+  auto source = MakeSource(static_cast<std::size_t>(state.range(0)));
+  compiler::KeywordTable keyword_table{};
+
+  for (auto _ : state) {
+    compiler::SourceBuffer source_buffer{source};
+    compiler::Tokenizer tokenizer{source_buffer, keyword_table};
+    std::ostringstream stream{};
+    benchmark::DoNotOptimize(compiler::WriteTokens(tokenizer, stream));
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * source.size()));
+}
+BENCHMARK(BM_Serial)->Arg(1)->Arg(64)->Arg(1024)->UseRealTime();
+
+/// Lexes on a producer thread while the calling thread emits tokens.
+void BM_Pipelined(benchmark::State& state) {
+  auto source = MakeSource(static_cast<std::size_t>(state.range(0)));
+  compiler::KeywordTable keyword_table{};
+
+  for (auto _ : state) {
+    compiler::SourceBuffer source_buffer{source};
+    compiler::PipelinedTokenizer tokenizer{source_buffer, keyword_table};
+    std::ostringstream stream{};
+    benchmark::DoNotOptimize(compiler::WriteTokens(tokenizer, stream));
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * source.size()));
+}
+BENCHMARK(BM_Pipelined)->Arg(1)->Arg(64)->Arg(1024)->UseRealTime();
+
+/// Time until the first `kBatchSize` tokens are available on the calling thread.
+void BM_SerialFirstBatch(benchmark::State& state) {
+  auto source = MakeSource(static_cast<std::size_t>(state.range(0)));
+  compiler::KeywordTable keyword_table{};
+
+  for (auto _ : state) {
+    auto begin = std::chrono::steady_clock::now();
+    compiler::SourceBuffer source_buffer{source};
+    compiler::Tokenizer tokenizer{source_buffer, keyword_table};
+    for (std::size_t index = 0; index < compiler::PipelinedTokenizer::kBatchSize; ++index) {
+      benchmark::DoNotOptimize(tokenizer.Tokenize());
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    state.SetIterationTime(elapsed.count());
+  }
+}
+BENCHMARK(BM_SerialFirstBatch)->Arg(1024)->UseManualTime();
+
+/// Time until the first batch reaches the consumer, thread start included. The
+/// producer is stopped outside of the measured time.
+void BM_PipelinedFirstBatch(benchmark::State& state) {
+  auto source = MakeSource(static_cast<std::size_t>(state.range(0)));
+  compiler::KeywordTable keyword_table{};
+
+  for (auto _ : state) {
+    auto begin = std::chrono::steady_clock::now();
+    compiler::SourceBuffer source_buffer{source};
+    compiler::PipelinedTokenizer tokenizer{source_buffer, keyword_table};
+    benchmark::DoNotOptimize(tokenizer.Next());
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    state.SetIterationTime(elapsed.count());
+  }
+}
+BENCHMARK(BM_PipelinedFirstBatch)->Arg(1024)->UseManualTime();
+
+}  // namespace
@@ -0,0 +1,104 @@
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+#include <compiler/io/source_buffer.h>
+
+#include <compiler/token/keyword_table.h>
+#include <compiler/token/scanner.h>
+#include <compiler/token/tokenizer.h>
+
+namespace {
+
+std::string MakeSource(std::size_t repetitions) {
+  std::ifstream stream{COMPILER_INPUT};
+  std::string unit{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+  std::string source{};
+  for (std::size_t index = 0; index < repetitions; ++index) {
+    source += unit;
+  }
+  return source;
+}
+
+struct CountingVisitor {
+  bool OnKeyword(compiler::Keyword, std::string_view) noexcept {
+    ++token_count;
+    return true;
+  }
+
+  bool OnControl(compiler::Control, std::string_view) noexcept {
+    ++token_count;
+    return true;
+  }
+
+  bool OnCharacterLiteral(char, std::string_view) noexcept {
+    ++token_count;
+    return true;
+  }
+
+  bool OnNumericLiteral(int, std::string_view) noexcept {
+    ++token_count;
+    return true;
+  }
+
+  bool OnStringLiteral(std::string_view) noexcept {
+    ++token_count;
+    return true;
+  }
+
+  bool OnIdentifier(std::string_view) noexcept {
+    ++token_count;
+    return true;
+  }
+
+  void OnCompilationUnitEnd() noexcept {
+  }
+
+  std::size_t token_count{};
+};
+
+void BM_Tokenizer(benchmark::State& state) {
+  auto source = MakeSource(static_cast<std::size_t>(state.range(0)));
+  compiler::KeywordTable keyword_table{};
+
+  for (auto _ : state) {
+    compiler::SourceBuffer source_buffer{source};
+    compiler::Tokenizer tokenizer{source_buffer, keyword_table};
+    std::size_t token_count{};
+    bool compilation_unit_found{false};
+    while (!compilation_unit_found) {
+      tokenizer.Tokenize().Match(
+        [&](compiler::CompilationUnitEnd) {
+          compilation_unit_found = true;
+        },
+        [&](const auto&) {
+          ++token_count;
+        }
+      );
+    }
+    benchmark::DoNotOptimize(token_count);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * source.size()));
+}
+BENCHMARK(BM_Tokenizer)->Arg(1)->Arg(1024);
+
+void BM_Scanner(benchmark::State& state) {
+  auto source = MakeSource(static_cast<std::size_t>(state.range(0)));
+  compiler::KeywordTable keyword_table{};
+
+  for (auto _ : state) {
+    CountingVisitor visitor{};
+    compiler::Scanner scanner{source, keyword_table, visitor};
+    scanner.Scan();
+    benchmark::DoNotOptimize(visitor.token_count);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * source.size()));
+}
+BENCHMARK(BM_Scanner)->Arg(1)->Arg(1024);
+
+}  // namespace
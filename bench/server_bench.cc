@@ -0,0 +1,80 @@
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+#include <compiler/server/client.h>
+#include <compiler/server/server.h>
+
+extern char** environ;
+
+namespace {
+
+constexpr const char* kSocketPath = "/tmp/compiler_server_bench.sock";
+
+/// Lexes the input by a fresh `compiler.out` process, as a build system does today.
+void BM_ColdInvocation(benchmark::State& state) {
+  posix_spawn_file_actions_t actions{};
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+
+  char binary[] = COMPILER_BINARY;
+  char input[] = COMPILER_INPUT;
+  char* argv[] = {binary, input, nullptr};
+
+  for (auto _ : state) {
+    pid_t pid{};
+    if (posix_spawn(&pid, binary, &actions, nullptr, argv, environ) != 0) {
+      state.SkipWithError("unable to spawn compiler");
+      break;
+    }
+    int status{};
+    waitpid(pid, &status, 0);
+  }
+
+  posix_spawn_file_actions_destroy(&actions);
+}
+BENCHMARK(BM_ColdInvocation)->UseRealTime();
+
+/// Lexes the input by a warm server, one connection per request.
+void BM_ServerRoundTrip(benchmark::State& state) {
+  compiler::Server server{kSocketPath, 1};
+  std::thread thread{[&server] {
+    server.Run();
+  }};
+
+  for (auto _ : state) {
+    compiler::Client client{kSocketPath};
+    benchmark::DoNotOptimize(client.LexFile(COMPILER_INPUT));
+  }
+
+  server.Stop();
+  thread.join();
+}
+BENCHMARK(BM_ServerRoundTrip)->UseRealTime();
+
+/// Lexes the input by a warm server over an already open connection.
+void BM_ServerPersistentConnection(benchmark::State& state) {
+  compiler::Server server{kSocketPath, 1};
+  std::thread thread{[&server] {
+    server.Run();
+  }};
+
+  {
+    compiler::Client client{kSocketPath};
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(client.LexFile(COMPILER_INPUT));
+    }
+  }
+
+  server.Stop();
+  thread.join();
+}
+BENCHMARK(BM_ServerPersistentConnection)->UseRealTime();
+
+}  // namespace
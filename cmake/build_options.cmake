@@ -6,4 +6,6 @@ option(BUILD_WITH_SAMPLE "enable build of samples" OFF)
 
 option(BUILD_WITH_TEST "enable build of tests" OFF)
 
-option(BUILD_WITH_BENCH "enable build of benchmarks" OFF)
\ No newline at end of file
+option(BUILD_WITH_BENCH "enable build of benchmarks" OFF)
+
+option(BUILD_WITH_FUZZ "enable build of fuzzing harnesses" OFF)
\ No newline at end of file
@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <compiler/io/source_buffer.h>
+
+#include <compiler/token/keyword_table.h>
+#include <compiler/token/pipelined_tokenizer.h>
+#include <compiler/token/scanner.h>
+#include <compiler/token/token_stream.h>
+#include <compiler/token/token_writer.h>
+#include <compiler/token/tokenizer.h>
+
+#include <differential.h>
+
+namespace compiler::fuzz::detail {
+
+/// Writes `Scanner` callbacks in the format of `WriteTokens`.
+class WritingVisitor final {
+ public:
+  WritingVisitor(std::ostream& stream) noexcept
+    : stream_{stream} {
+  }
+
+  bool OnKeyword(Keyword keyword, std::string_view) {
+    stream_ << "keyword: " << keyword << '\n';
+    return true;
+  }
+
+  bool OnControl(Control control, std::string_view) {
+    stream_ << "control: " << control << '\n';
+    return true;
+  }
+
+  bool OnCharacterLiteral(char character_literal, std::string_view) {
+    stream_ << "character literal: '" << character_literal << "'" << '\n';
+    return true;
+  }
+
+  bool OnNumericLiteral(int numeric_literal, std::string_view) {
+    stream_ << "numeric literal: " << numeric_literal << '\n';
+    return true;
+  }
+
+  bool OnStringLiteral(std::string_view span) {
+    // Spans keep escapes as written, `Tokenizer` drops the backslashes.
+    stream_ << "string literal: '";
+    for (std::size_t index = 0; index < span.size(); ++index) {
+      if (span[index] == '\\' && index + 1 < span.size()) {
+        ++index;
+      }
+      stream_ << span[index];
+    }
+    stream_ << "'" << '\n';
+    return true;
+  }
+
+  bool OnIdentifier(std::string_view span) {
+    stream_ << "identifier: '" << span << "'" << '\n';
+    return true;
+  }
+
+  void OnCompilationUnitEnd() noexcept {
+  }
+
+ private:
+  std::ostream& stream_;
+};
+
+const KeywordTable& GetKeywordTable() {
+  static const KeywordTable keyword_table{};
+  return keyword_table;
+}
+
+template <typename TLex>
+LexerRun Run(const char* lexer, TLex&& lex) {
+  std::ostringstream stream{};
+  auto begin = std::chrono::steady_clock::now();
+  try {
+    lex(stream);
+  } catch (const std::exception& exception) {
+    stream << "error: " << exception.what() << '\n';
+  }
+  auto end = std::chrono::steady_clock::now();
+  return LexerRun{lexer, stream.str(), end - begin};
+}
+
+std::string Repeat(std::string_view input, std::size_t min_size) {
+  std::string result{};
+  result.reserve(min_size + input.size());
+  while (result.size() < min_size) {
+    result += input;
+  }
+  return result;
+}
+
+std::string DescribeMismatch(const LexerRun& reference, const LexerRun& run) {
+  std::istringstream expected{reference.output};
+  std::istringstream actual{run.output};
+  std::string expected_line{};
+  std::string actual_line{};
+  for (std::size_t line = 1; ; ++line) {
+    bool has_expected = static_cast<bool>(std::getline(expected, expected_line));
+    bool has_actual = static_cast<bool>(std::getline(actual, actual_line));
+    if (!has_expected && !has_actual) {
+      break;
+    }
+    if (!has_expected || !has_actual || expected_line != actual_line) {
+      return std::string{run.lexer} + " differs from " + reference.lexer +
+             " at line " + std::to_string(line) + ": expected '" +
+             (has_expected ? expected_line : "<end>") + "', got '" +
+             (has_actual ? actual_line : "<end>") + "'";
+    }
+  }
+  return {};
+}
+
+/// Keeps the fastest of `repetition_count` runs of every lexer on `input`, so
+/// scheduling noise of single samples does not count.
+std::vector<LexerRun> RunFastest(std::string_view input, std::size_t repetition_count) {
+  std::vector<LexerRun> runs{};
+  for (std::size_t repetition = 0; repetition < repetition_count; ++repetition) {
+    auto report = RunDifferential(input);
+    if (runs.empty()) {
+      runs = std::move(report.runs);
+      continue;
+    }
+    for (std::size_t index = 0; index < runs.size(); ++index) {
+      runs[index].duration = std::min(runs[index].duration, report.runs[index].duration);
+    }
+  }
+  return runs;
+}
+
+}  // namespace compiler::fuzz::detail
+
+namespace compiler::fuzz {
+
+DifferentialReport RunDifferential(std::string_view input) {
+  const auto& keyword_table = detail::GetKeywordTable();
+
+  DifferentialReport report{};
+  report.runs.push_back(detail::Run("tokenizer", [&](std::ostream& stream) {
+    SourceBuffer source_buffer{input};
+    Tokenizer tokenizer{source_buffer, keyword_table};
+    WriteTokens(tokenizer, stream);
+  }));
+  report.runs.push_back(detail::Run("scanner", [&](std::ostream& stream) {
+    detail::WritingVisitor visitor{stream};
+    Scanner scanner{input, keyword_table, visitor};
+    scanner.Scan();
+  }));
+  report.runs.push_back(detail::Run("pipelined", [&](std::ostream& stream) {
+    SourceBuffer source_buffer{input};
+    PipelinedTokenizer tokenizer{source_buffer, keyword_table};
+    WriteTokens(tokenizer, stream);
+  }));
+  report.runs.push_back(detail::Run("generator", [&](std::ostream& stream) {
+    SourceBuffer source_buffer{input};
+    TokenStream token_stream{GenerateTokens(source_buffer, keyword_table)};
+    WriteTokens(token_stream, stream);
+  }));
+
+  for (std::size_t index = 1; index < report.runs.size(); ++index) {
+    report.mismatch = detail::DescribeMismatch(report.runs.front(), report.runs[index]);
+    if (!report.mismatch.empty()) {
+      break;
+    }
+  }
+  return report;
+}
+
+std::vector<std::chrono::nanoseconds> MeasureSetupCosts() {
+  static constexpr std::size_t kRepetitionCount = 16;
+
+  std::vector<std::chrono::nanoseconds> setup_costs{};
+  for (const auto& run : detail::RunFastest({}, kRepetitionCount)) {
+    setup_costs.push_back(run.duration);
+  }
+  return setup_costs;
+}
+
+std::string FindSlowRun(const DifferentialReport& report,
+                        std::size_t input_size,
+                        const std::vector<std::chrono::nanoseconds>& setup_costs,
+                        double max_ns_per_byte) {
+  static constexpr std::chrono::nanoseconds kSlack = std::chrono::milliseconds{1};
+
+  for (std::size_t index = 0; index < report.runs.size() && index < setup_costs.size(); ++index) {
+    const auto& run = report.runs[index];
+    auto budget = std::chrono::duration<double, std::nano>{setup_costs[index] + kSlack} +
+                  std::chrono::duration<double, std::nano>{max_ns_per_byte * static_cast<double>(input_size)};
+    if (run.duration > budget) {
+      return std::string{run.lexer} + " took " + std::to_string(run.duration.count()) +
+             " ns on " + std::to_string(input_size) + " bytes, setup cost " +
+             std::to_string(setup_costs[index].count()) + " ns";
+    }
+  }
+  return {};
+}
+
+std::string FindSuperlinearRun(std::string_view input,
+                               const std::vector<std::chrono::nanoseconds>& setup_costs,
+                               double max_growth) {
+  static constexpr std::size_t kRepetitionCount = 5;
+
+  if (input.empty()) {
+    return {};
+  }
+
+  auto short_input = detail::Repeat(input, kGrowthBaseSize);
+  auto screening_report = RunDifferential(short_input);
+  if (FindSlowRun(screening_report, short_input.size(), setup_costs, kScreeningNsPerByte).empty()) {
+    return {};
+  }
+
+  auto long_input = detail::Repeat(short_input, kGrowthFactor * short_input.size());
+  auto short_runs = detail::RunFastest(short_input, kRepetitionCount);
+  auto long_runs = detail::RunFastest(long_input, kRepetitionCount);
+
+  for (std::size_t index = 0; index < short_runs.size() && index < long_runs.size(); ++index) {
+    auto short_duration = std::max(short_runs[index].duration, std::chrono::nanoseconds{1});
+    auto long_duration = long_runs[index].duration;
+    auto growth = static_cast<double>(long_duration.count()) /
+                  static_cast<double>(short_duration.count()) / static_cast<double>(kGrowthFactor);
+    if (growth > max_growth) {
+      return std::string{short_runs[index].lexer} + " grows " + std::to_string(growth) +
+             " times per byte from " + std::to_string(short_input.size()) + " bytes (" +
+             std::to_string(short_duration.count()) + " ns) to " +
+             std::to_string(long_input.size()) + " bytes (" +
+             std::to_string(long_duration.count()) + " ns)";
+    }
+  }
+  return {};
+}
+
+}  // namespace compiler::fuzz
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace compiler::fuzz {
+
+/// @brief An outcome of lexing an input by a single lexer implementation.
+struct LexerRun {
+  const char* lexer;
+  /// Token lines as written by `WriteTokens`, followed by "error: <what>"
+  /// line if lexing has failed.
+  std::string output;
+  std::chrono::nanoseconds duration;
+};
+
+struct DifferentialReport {
+  /// The reference `Tokenizer` run comes first.
+  std::vector<LexerRun> runs;
+  /// Empty if all runs agree with the reference one.
+  std::string mismatch;
+};
+
+/// @brief Lexes `input` by the reference `Tokenizer` and by every alternative
+/// path built on or next to it, and compares their token streams and errors.
+DifferentialReport RunDifferential(std::string_view input);
+
+/// @brief Measures a fixed cost of every lexer on empty input, e.g. starting
+/// the pipelined producer thread, in the order of `DifferentialReport::runs`.
+std::vector<std::chrono::nanoseconds> MeasureSetupCosts();
+
+/// @brief Screens run durations against `max_ns_per_byte` once the setup cost
+/// of a lexer is subtracted. A fixed slack absorbs scheduling noise.
+///
+/// A single wall-clock sample is only a hint, a flagged input has to be
+/// confirmed by `FindSuperlinearRun`.
+///
+/// @return A description of the first run over the budget, empty if none is.
+std::string FindSlowRun(const DifferentialReport& report,
+                        std::size_t input_size,
+                        const std::vector<std::chrono::nanoseconds>& setup_costs,
+                        double max_ns_per_byte);
+
+/// Inputs are repeated up to at least this size before timing, so lexing
+/// rather than the setup cost dominates the shorter run.
+inline constexpr std::size_t kGrowthBaseSize = 4096;
+/// The longer run lexes the shorter input repeated this many times.
+inline constexpr std::size_t kGrowthFactor = 8;
+/// Linear lexers stay well below the limit even in sanitized builds, a
+/// quadratic one passes it from about a thousand bytes on.
+inline constexpr double kScreeningNsPerByte = 500.0;
+/// Leaves room for cache effects and noise, a quadratic lexer grows by `kGrowthFactor`.
+inline constexpr double kDefaultMaxGrowth = 3.0;
+
+/// @brief Looks for a lexer whose cost per byte grows with the input.
+///
+/// `input` is repeated up to `kGrowthBaseSize` and screened by a single run
+/// with `FindSlowRun`. Load only makes the sample slower, so the screen lets
+/// no slow lexer through, it just lets most inputs skip the measurement.
+/// Screened inputs are timed at two sizes `kGrowthFactor` apart, taking the
+/// minimum of several runs for each size. The growth of the cost per byte
+/// stays around 1 for a linear lexer and reaches `kGrowthFactor` for a
+/// quadratic one regardless of the machine and its load.
+///
+/// @return A description of the first lexer whose cost per byte grows more
+/// than `max_growth` times, empty if none does or if `input` is empty.
+std::string FindSuperlinearRun(std::string_view input,
+                               const std::vector<std::chrono::nanoseconds>& setup_costs,
+                               double max_growth);
+
+}  // namespace compiler::fuzz
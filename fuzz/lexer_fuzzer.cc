@@ -0,0 +1,34 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+
+#include <differential.h>
+
+/// The libFuzzer entry point, `lexer_replay.out` replays found inputs without libFuzzer.
+///
+/// Aborts on a mismatch between lexers and on a superlinear lexer. Only inputs
+/// that the fuzzing run itself screens as slow are handed to
+/// `FindSuperlinearRun`, which keeps the throughput, and only a growth
+/// confirmed over repeated runs aborts, so a busy machine does not.
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+  static const auto setup_costs = compiler::fuzz::MeasureSetupCosts();
+
+  std::string_view input{reinterpret_cast<const char*>(data), size};
+  auto report = compiler::fuzz::RunDifferential(input);
+  if (!report.mismatch.empty()) {
+    std::cerr << report.mismatch << std::endl;
+    std::abort();
+  }
+  if (compiler::fuzz::FindSlowRun(report, size, setup_costs, compiler::fuzz::kScreeningNsPerByte).empty()) {
+    return 0;
+  }
+  auto superlinear_run =
+      compiler::fuzz::FindSuperlinearRun(input, setup_costs, compiler::fuzz::kDefaultMaxGrowth);
+  if (!superlinear_run.empty()) {
+    std::cerr << superlinear_run << std::endl;
+    std::abort();
+  }
+  return 0;
+}
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <differential.h>
+
+namespace {
+
+struct LexerStatistics {
+  std::size_t byte_count{};
+  std::chrono::nanoseconds duration{};
+  double slowest_ns_per_byte{};
+  std::string slowest_input{};
+};
+
+/// @return False if any of `paths` does not exist or cannot be listed.
+bool CollectInputs(const std::vector<std::filesystem::path>& paths,
+                   std::vector<std::filesystem::path>& inputs) {
+  for (const auto& path : paths) {
+    std::error_code error{};
+    auto status = std::filesystem::status(path, error);
+    if (std::filesystem::is_directory(status)) {
+      std::filesystem::recursive_directory_iterator iterator{path, error};
+      for (; !error && iterator != std::filesystem::recursive_directory_iterator{};
+           iterator.increment(error)) {
+        if (iterator->is_regular_file()) {
+          inputs.push_back(iterator->path());
+        }
+      }
+    } else if (std::filesystem::exists(status)) {
+      inputs.push_back(path);
+    } else if (!error) {
+      error = std::make_error_code(std::errc::no_such_file_or_directory);
+    }
+    if (error) {
+      std::cerr << "cannot collect inputs from " << path.string() << ": " << error.message() << '\n';
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ReadInput(const std::filesystem::path& path, std::string& input) {
+  std::ifstream stream{path, std::ios::binary};
+  if (!stream) {
+    return false;
+  }
+  input.assign(std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{});
+  return !stream.bad();
+}
+
+bool ParseLimit(const char* text, double& limit) {
+  char* end{};
+  errno = 0;
+  limit = std::strtod(text, &end);
+  return end != text && *end == '\0' && errno == 0 && std::isfinite(limit) && limit > 0.0;
+}
+
+void PrintUsage() {
+  std::cerr << "usage: lexer_replay.out [--max-growth <limit>] <file or directory>...\n";
+}
+
+}  // namespace
+
+/// Replays a corpus through the differential harness without libFuzzer.
+///
+/// Usage:
+///   lexer_replay.out [--max-growth <limit>] <file or directory>...
+/// Fails if lexers disagree on any input or if the cost per byte of any lexer
+/// grows more than `limit` times on the input repeated `kGrowthFactor` times
+/// longer, see `FindSuperlinearRun`. Missing or unreadable inputs fail as well.
+int main(int argc, char** argv) {
+  double max_growth{compiler::fuzz::kDefaultMaxGrowth};
+  std::vector<std::filesystem::path> paths{};
+  for (int index = 1; index < argc; ++index) {
+    if (std::strcmp(argv[index], "--max-growth") == 0) {
+      if (index + 1 == argc || !ParseLimit(argv[index + 1], max_growth)) {
+        std::cerr << "--max-growth requires a positive number\n";
+        return EXIT_FAILURE;
+      }
+      ++index;
+    } else if (std::strncmp(argv[index], "--", 2) == 0) {
+      PrintUsage();
+      return EXIT_FAILURE;
+    } else {
+      paths.emplace_back(argv[index]);
+    }
+  }
+  if (paths.empty()) {
+    PrintUsage();
+    return EXIT_FAILURE;
+  }
+
+  std::vector<std::filesystem::path> inputs{};
+  if (!CollectInputs(paths, inputs)) {
+    return EXIT_FAILURE;
+  }
+  auto setup_costs = compiler::fuzz::MeasureSetupCosts();
+  std::vector<LexerStatistics> statistics{};
+  std::vector<const char*> lexers{};
+  std::size_t mismatch_count{};
+  std::size_t slow_count{};
+
+  for (const auto& path : inputs) {
+    std::string input{};
+    if (!ReadInput(path, input)) {
+      std::cerr << "cannot read input: " << path.string() << '\n';
+      return EXIT_FAILURE;
+    }
+
+    auto report = compiler::fuzz::RunDifferential(input);
+    if (!report.mismatch.empty()) {
+      std::cout << "MISMATCH " << path.string() << ": " << report.mismatch << '\n';
+      ++mismatch_count;
+    }
+    auto superlinear_run = compiler::fuzz::FindSuperlinearRun(input, setup_costs, max_growth);
+    if (!superlinear_run.empty()) {
+      std::cout << "SLOW " << path.string() << ": " << superlinear_run << '\n';
+      ++slow_count;
+    }
+
+    statistics.resize(report.runs.size());
+    lexers.resize(report.runs.size());
+    for (std::size_t index = 0; index < report.runs.size(); ++index) {
+      const auto& run = report.runs[index];
+      auto& lexer_statistics = statistics[index];
+      lexers[index] = run.lexer;
+      lexer_statistics.byte_count += input.size();
+      lexer_statistics.duration += run.duration;
+      if (input.empty() || index >= setup_costs.size()) {
+        continue;
+      }
+      auto lexing_duration = std::max(run.duration - setup_costs[index], std::chrono::nanoseconds{});
+      auto ns_per_byte = static_cast<double>(lexing_duration.count()) / static_cast<double>(input.size());
+      if (ns_per_byte > lexer_statistics.slowest_ns_per_byte) {
+        lexer_statistics.slowest_ns_per_byte = ns_per_byte;
+        lexer_statistics.slowest_input = path.string();
+      }
+    }
+  }
+
+  std::cout << "replayed " << inputs.size() << " inputs\n";
+  for (std::size_t index = 0; index < statistics.size(); ++index) {
+    const auto& lexer_statistics = statistics[index];
+    auto seconds = std::chrono::duration<double>{lexer_statistics.duration}.count();
+    std::cout << lexers[index] << ": "
+              << static_cast<double>(lexer_statistics.byte_count) / 1e6 / seconds << " MB/s";
+    if (!lexer_statistics.slowest_input.empty()) {
+      std::cout << ", slowest " << lexer_statistics.slowest_ns_per_byte << " ns/byte on "
+                << lexer_statistics.slowest_input;
+    }
+    std::cout << '\n';
+  }
+
+  return mismatch_count == 0 && slow_count == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,58 @@
+#include <compiler/common/common.h>
+
+#include <compiler/ast/ast.h>
+
+namespace compiler {
+
+Ast::Ast() noexcept
+  : nodes_{}
+  , symbol_text_{}
+  , symbol_offsets_{} {
+}
+
+NodeIndex Ast::AddNode(Node node) {
+  ASSERT(nodes_.size() < kNullNode);
+
+  nodes_.push_back(node);
+  return static_cast<NodeIndex>(nodes_.size() - 1);
+}
+
+void Ast::SetNextSibling(NodeIndex node, NodeIndex next_sibling) noexcept {
+  ASSERT(node < nodes_.size());
+
+  nodes_[node].next_sibling = next_sibling;
+}
+
+const Node& Ast::GetNode(NodeIndex index) const noexcept {
+  ASSERT(index < nodes_.size());
+
+  return nodes_[index];
+}
+
+std::size_t Ast::GetNodeCount() const noexcept {
+  return nodes_.size();
+}
+
+std::uint32_t Ast::AddSymbol(std::string_view symbol) {
+  if (symbol_offsets_.empty()) {
+    symbol_offsets_.push_back(0);
+  }
+  symbol_text_.append(symbol);
+  symbol_offsets_.push_back(static_cast<std::uint32_t>(symbol_text_.size()));
+  return static_cast<std::uint32_t>(symbol_offsets_.size() - 2);
+}
+
+std::string_view Ast::GetSymbol(std::uint32_t index) const noexcept {
+  ASSERT(index + 1 < symbol_offsets_.size());
+
+  std::string_view text{symbol_text_};
+  return text.substr(symbol_offsets_[index], symbol_offsets_[index + 1] - symbol_offsets_[index]);
+}
+
+std::size_t Ast::GetMemoryUsage() const noexcept {
+  return nodes_.capacity() * sizeof(Node) +
+         symbol_text_.capacity() +
+         symbol_offsets_.capacity() * sizeof(std::uint32_t);
+}
+
+}  // namespace compiler
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace compiler {
+
+using NodeIndex = std::uint32_t;
+
+constexpr NodeIndex kNullNode = static_cast<NodeIndex>(-1);
+
+/// @brief An enumeration represents kinds of syntax tree nodes. Children are
+/// listed in order, the ones in brackets are optional.
+enum NodeKind : std::uint8_t {
+  kTranslationUnitNode,                 // function definitions and declarations
+  kFunctionDefinitionNode,              // parameter list, body; type in `operation`, name in `value`
+  kParameterListNode,                   // parameters
+  kParameterNode,                       // -; type in `operation`, name in `value`
+  kCompoundStatementNode,               // statements
+  kDeclarationNode,                     // declarators; type in `operation`
+  kDeclaratorNode,                      // [initializer]; name in `value`
+  kIfStatementNode,                     // condition, then, [else]
+  kForStatementNode,                    // init, condition, step, body; absent ones are empty nodes
+  kWhileStatementNode,                  // condition, body
+  kReturnStatementNode,                 // [value]
+  kBreakStatementNode,                  // -
+  kContinueStatementNode,               // -
+  kExpressionStatementNode,             // expression
+  kEmptyNode,                           // -
+  kAssignmentExpressionNode,            // target, value; operator in `operation`
+  kBinaryExpressionNode,                // left, right; operator in `operation`
+  kUnaryExpressionNode,                 // operand; operator in `operation`
+  kPostfixExpressionNode,               // operand; operator in `operation`
+  kCallExpressionNode,                  // callee, arguments
+  kSubscriptExpressionNode,             // array, index
+  kIdentifierNode,                      // -; name in `value`
+  kNumericLiteralNode,                  // -; value in `value`
+  kCharacterLiteralNode,                // -; value in `value`
+  kStringLiteralNode,                   // -; text in `value`
+};
+
+/// @brief A fixed-size tree node. Children form a singly linked list through
+/// `next_sibling`, so links are 32-bit indices into the owning `Ast` rather
+/// than pointers.
+struct Node {
+  NodeKind kind;
+  /// `Control` of an operator or `Keyword` of a type.
+  std::uint8_t operation;
+  /// A symbol index, a literal value or zero, depending on `kind`.
+  std::uint32_t value;
+  NodeIndex first_child;
+  NodeIndex next_sibling;
+};
+
+/// @brief A syntax tree of a compilation unit stored in a single contiguous
+/// arena. Nodes are trivially destructible and names are kept in one shared
+/// buffer, so releasing a tree is a constant number of deallocations.
+class Ast final {
+ public:
+  Ast() noexcept;
+
+  NodeIndex AddNode(Node node);
+
+  void SetNextSibling(NodeIndex node, NodeIndex next_sibling) noexcept;
+
+  const Node& GetNode(NodeIndex index) const noexcept;
+
+  std::size_t GetNodeCount() const noexcept;
+
+  /// @return The index of the added symbol, stored in `Node::value`.
+  std::uint32_t AddSymbol(std::string_view symbol);
+
+  std::string_view GetSymbol(std::uint32_t index) const noexcept;
+
+  /// @return Bytes held by the arena, node and symbol storage included.
+  std::size_t GetMemoryUsage() const noexcept;
+
+ private:
+  std::vector<Node> nodes_;
+  std::string symbol_text_;
+  std::vector<std::uint32_t> symbol_offsets_;
+};
+
+}  // namespace compiler
@@ -0,0 +1,179 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <compiler/common/common.h>
+
+#include <compiler/ast/ast_writer.h>
+
+namespace compiler::detail {
+
+const char* GetNodeKindName(NodeKind kind) noexcept {
+  switch (kind) {
+    case kTranslationUnitNode: {
+      return "translation unit";
+    }
+    case kFunctionDefinitionNode: {
+      return "function definition";
+    }
+    case kParameterListNode: {
+      return "parameter list";
+    }
+    case kParameterNode: {
+      return "parameter";
+    }
+    case kCompoundStatementNode: {
+      return "compound statement";
+    }
+    case kDeclarationNode: {
+      return "declaration";
+    }
+    case kDeclaratorNode: {
+      return "declarator";
+    }
+    case kIfStatementNode: {
+      return "if statement";
+    }
+    case kForStatementNode: {
+      return "for statement";
+    }
+    case kWhileStatementNode: {
+      return "while statement";
+    }
+    case kReturnStatementNode: {
+      return "return statement";
+    }
+    case kBreakStatementNode: {
+      return "break statement";
+    }
+    case kContinueStatementNode: {
+      return "continue statement";
+    }
+    case kExpressionStatementNode: {
+      return "expression statement";
+    }
+    case kEmptyNode: {
+      return "empty";
+    }
+    case kAssignmentExpressionNode: {
+      return "assignment expression";
+    }
+    case kBinaryExpressionNode: {
+      return "binary expression";
+    }
+    case kUnaryExpressionNode: {
+      return "unary expression";
+    }
+    case kPostfixExpressionNode: {
+      return "postfix expression";
+    }
+    case kCallExpressionNode: {
+      return "call expression";
+    }
+    case kSubscriptExpressionNode: {
+      return "subscript expression";
+    }
+    case kIdentifierNode: {
+      return "identifier";
+    }
+    case kNumericLiteralNode: {
+      return "numeric literal";
+    }
+    case kCharacterLiteralNode: {
+      return "character literal";
+    }
+    case kStringLiteralNode: {
+      return "string literal";
+    }
+  }
+  UNREACHABLE();
+}
+
+void WriteNode(const Ast& ast, const Node& node, std::size_t depth, std::ostream& stream) {
+  // Indentation is capped so that output stays linear in the node count for
+  // degenerate trees, deeper nodes state their depth instead.
+  static constexpr std::size_t kMaxIndentedDepth = 32;
+
+  for (std::size_t level = 0; level < depth && level < kMaxIndentedDepth; ++level) {
+    stream << "  ";
+  }
+  if (depth > kMaxIndentedDepth) {
+    stream << '[' << depth << "] ";
+  }
+  stream << GetNodeKindName(node.kind);
+  switch (node.kind) {
+    case kFunctionDefinitionNode:
+    case kParameterNode: {
+      stream << ": type " << static_cast<int>(node.operation)
+             << ", name '" << ast.GetSymbol(node.value) << "'";
+      break;
+    }
+    case kDeclarationNode: {
+      stream << ": type " << static_cast<int>(node.operation);
+      break;
+    }
+    case kDeclaratorNode:
+    case kIdentifierNode: {
+      stream << ": '" << ast.GetSymbol(node.value) << "'";
+      break;
+    }
+    case kAssignmentExpressionNode:
+    case kBinaryExpressionNode:
+    case kUnaryExpressionNode:
+    case kPostfixExpressionNode: {
+      stream << ": control " << static_cast<int>(node.operation);
+      break;
+    }
+    case kNumericLiteralNode: {
+      stream << ": " << static_cast<std::int32_t>(node.value);
+      break;
+    }
+    case kCharacterLiteralNode: {
+      stream << ": '" << static_cast<char>(node.value) << "'";
+      break;
+    }
+    case kStringLiteralNode: {
+      stream << ": '" << ast.GetSymbol(node.value) << "'";
+      break;
+    }
+    default: {
+      break;
+    }
+  }
+  stream << '\n';
+}
+
+}  // namespace compiler::detail
+
+namespace compiler {
+
+void WriteAst(const Ast& ast, NodeIndex root, std::ostream& stream) {
+  struct PendingNode {
+    NodeIndex index;
+    std::size_t depth;
+  };
+
+  // Walks the tree with an explicit stack, a chain of binary operators alone
+  // makes it as deep as the expression is long.
+  const auto& root_node = ast.GetNode(root);
+  detail::WriteNode(ast, root_node, 0, stream);
+  std::vector<PendingNode> pending{};
+  if (root_node.first_child != kNullNode) {
+    pending.push_back({root_node.first_child, 1});
+  }
+  while (!pending.empty()) {
+    auto [index, depth] = pending.back();
+    pending.pop_back();
+    const auto& node = ast.GetNode(index);
+    detail::WriteNode(ast, node, depth, stream);
+    // The sibling is pushed first, so the whole subtree is written before it.
+    if (node.next_sibling != kNullNode) {
+      pending.push_back({node.next_sibling, depth});
+    }
+    if (node.first_child != kNullNode) {
+      pending.push_back({node.first_child, depth + 1});
+    }
+  }
+}
+
+}  // namespace compiler
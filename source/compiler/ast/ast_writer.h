@@ -0,0 +1,14 @@
+#pragma once
+
+#include <ostream>
+
+#include <compiler/ast/ast.h>
+
+namespace compiler {
+
+/// @brief Writes the tree rooted at `root` one node per line, children
+/// indented under their parent. Past 32 levels the indentation stops growing
+/// and lines are prefixed with the depth in brackets.
+void WriteAst(const Ast& ast, NodeIndex root, std::ostream& stream);
+
+}  // namespace compiler
@@ -0,0 +1,576 @@
+#include <vector>
+
+#include <compiler/ast/parser.h>
+
+namespace compiler::detail {
+
+/// @return Precedence of a binary operator, the higher the tighter it binds,
+/// or zero if `control` is not a binary operator.
+int GetBinaryPrecedence(Control control) noexcept {
+  switch (control) {
+    case kPipePipe: {
+      return 1;
+    }
+    case kAmpersandAmpersand: {
+      return 2;
+    }
+    case kPipe: {
+      return 3;
+    }
+    case kCaret: {
+      return 4;
+    }
+    case kAmpersand: {
+      return 5;
+    }
+    case kEqualEqual: {
+      return 6;
+    }
+    case kLess:
+    case kLessEqual:
+    case kGreater:
+    case kGreaterEqual: {
+      return 7;
+    }
+    case kLessLess:
+    case kGreaterGreater: {
+      return 8;
+    }
+    case kPlus:
+    case kMinus: {
+      return 9;
+    }
+    case kStar:
+    case kSlash:
+    case kPercent: {
+      return 10;
+    }
+    default: {
+      return 0;
+    }
+  }
+}
+
+bool IsAssignment(Control control) noexcept {
+  switch (control) {
+    case kEqual:
+    case kPlusEqual:
+    case kMinusEqual:
+    case kStarEqual:
+    case kSlashEqual:
+    case kPercentEqual:
+    case kAmpersandEqual:
+    case kPipeEqual:
+    case kCaretEqual:
+    case kLessLessEqual:
+    case kGreaterGreaterEqual: {
+      return true;
+    }
+    default: {
+      return false;
+    }
+  }
+}
+
+bool IsUnary(Control control) noexcept {
+  switch (control) {
+    case kPlus:
+    case kMinus:
+    case kExclamation:
+    case kTilde:
+    case kPlusPlus:
+    case kMinusMinus:
+    case kStar:
+    case kAmpersand: {
+      return true;
+    }
+    default: {
+      return false;
+    }
+  }
+}
+
+bool IsType(Keyword keyword) noexcept {
+  switch (keyword) {
+    case kChar:
+    case kDouble:
+    case kFloat:
+    case kInt:
+    case kLong:
+    case kShort:
+    case kSigned:
+    case kUnsigned:
+    case kVoid: {
+      return true;
+    }
+    default: {
+      return false;
+    }
+  }
+}
+
+}  // namespace compiler::detail
+
+namespace compiler {
+
+const char* UnexpectedToken::what() const noexcept {
+  return "unexpected token";
+}
+
+const char* NestingTooDeep::what() const noexcept {
+  return "nesting too deep";
+}
+
+Parser::NestingGuard::NestingGuard(std::size_t& depth)
+  : depth_{depth} {
+  if (depth_ == kMaxNestingDepth) {
+    throw NestingTooDeep{};
+  }
+  ++depth_;
+}
+
+Parser::NestingGuard::~NestingGuard() noexcept {
+  --depth_;
+}
+
+Parser::Parser(TokenStream& stream, Ast& ast) noexcept
+  : stream_{stream}
+  , ast_{ast}
+  , symbols_{}
+  , depth_{} {
+}
+
+NodeIndex Parser::ParseTranslationUnit() {
+  auto first = kNullNode;
+  auto last = kNullNode;
+  while (!IsCompilationUnitEnd()) {
+    AppendChild(first, last, ParseExternalDeclaration());
+  }
+  return ast_.AddNode(Node{kTranslationUnitNode, 0, 0, first, kNullNode});
+}
+
+std::optional<Control> Parser::PeekControl(std::size_t k) {
+  std::optional<Control> control{};
+  stream_.Peek(k).Match(
+    [&](Control value) {
+      control = value;
+    },
+    [](const auto&) {
+    }
+  );
+  return control;
+}
+
+std::optional<Keyword> Parser::PeekKeyword(std::size_t k) {
+  std::optional<Keyword> keyword{};
+  stream_.Peek(k).Match(
+    [&](Keyword value) {
+      keyword = value;
+    },
+    [](const auto&) {
+    }
+  );
+  return keyword;
+}
+
+bool Parser::IsControl(Control control, std::size_t k) {
+  return PeekControl(k) == control;
+}
+
+bool Parser::IsKeyword(Keyword keyword, std::size_t k) {
+  return PeekKeyword(k) == keyword;
+}
+
+bool Parser::IsType(std::size_t k) {
+  auto keyword = PeekKeyword(k);
+  return keyword && detail::IsType(*keyword);
+}
+
+bool Parser::IsCompilationUnitEnd() {
+  bool compilation_unit_found{false};
+  stream_.Peek().Match(
+    [&](CompilationUnitEnd) {
+      compilation_unit_found = true;
+    },
+    [](const auto&) {
+    }
+  );
+  return compilation_unit_found;
+}
+
+void Parser::Expect(Control control) {
+  if (!IsControl(control)) {
+    throw UnexpectedToken{};
+  }
+  stream_.Consume();
+}
+
+void Parser::Expect(Keyword keyword) {
+  if (!IsKeyword(keyword)) {
+    throw UnexpectedToken{};
+  }
+  stream_.Consume();
+}
+
+Keyword Parser::ExpectType() {
+  auto keyword = PeekKeyword();
+  if (!keyword || !detail::IsType(*keyword)) {
+    throw UnexpectedToken{};
+  }
+  stream_.Consume();
+  return *keyword;
+}
+
+std::uint32_t Parser::ExpectIdentifier() {
+  std::optional<std::uint32_t> symbol{};
+  stream_.Peek().Match(
+    [&](const Identifier& identifier) {
+      symbol = Intern(identifier.value);
+    },
+    [](const auto&) {
+    }
+  );
+  if (!symbol) {
+    throw UnexpectedToken{};
+  }
+  stream_.Consume();
+  return *symbol;
+}
+
+std::uint32_t Parser::Intern(const std::string& symbol) {
+  auto iterator = symbols_.find(symbol);
+  if (iterator != symbols_.end()) {
+    return iterator->second;
+  }
+  auto index = ast_.AddSymbol(symbol);
+  symbols_.emplace(symbol, index);
+  return index;
+}
+
+NodeIndex Parser::AddNode(NodeKind kind,
+                          std::uint8_t operation,
+                          std::uint32_t value,
+                          std::initializer_list<NodeIndex> children) {
+  auto first = kNullNode;
+  auto last = kNullNode;
+  for (auto child : children) {
+    AppendChild(first, last, child);
+  }
+  return ast_.AddNode(Node{kind, operation, value, first, kNullNode});
+}
+
+void Parser::AppendChild(NodeIndex& first, NodeIndex& last, NodeIndex child) noexcept {
+  if (first == kNullNode) {
+    first = child;
+  } else {
+    ast_.SetNextSibling(last, child);
+  }
+  last = child;
+}
+
+NodeIndex Parser::ParseExternalDeclaration() {
+  // "type name (" starts a function definition, anything else is a declaration.
+  if (IsType() && IsControl(kOpenBracket, 2)) {
+    return ParseFunctionDefinition();
+  }
+  return ParseDeclaration();
+}
+
+NodeIndex Parser::ParseFunctionDefinition() {
+  auto type = ExpectType();
+  auto name = ExpectIdentifier();
+  auto parameter_list = ParseParameterList();
+  auto body = ParseCompoundStatement();
+  return AddNode(kFunctionDefinitionNode, type, name, {parameter_list, body});
+}
+
+NodeIndex Parser::ParseParameterList() {
+  Expect(kOpenBracket);
+  auto first = kNullNode;
+  auto last = kNullNode;
+  if (IsKeyword(kVoid) && IsControl(kCloseBracket, 1)) {
+    stream_.Consume();
+  } else if (!IsControl(kCloseBracket)) {
+    while (true) {
+      auto type = ExpectType();
+      auto name = ExpectIdentifier();
+      AppendChild(first, last, AddNode(kParameterNode, type, name));
+      if (!IsControl(kComma)) {
+        break;
+      }
+      stream_.Consume();
+    }
+  }
+  Expect(kCloseBracket);
+  return ast_.AddNode(Node{kParameterListNode, 0, 0, first, kNullNode});
+}
+
+NodeIndex Parser::ParseStatement() {
+  NestingGuard guard{depth_};
+  if (auto keyword = PeekKeyword()) {
+    switch (*keyword) {
+      case kIf: {
+        return ParseIfStatement();
+      }
+      case kFor: {
+        return ParseForStatement();
+      }
+      case kWhile: {
+        return ParseWhileStatement();
+      }
+      case kReturn: {
+        return ParseReturnStatement();
+      }
+      case kBreak: {
+        stream_.Consume();
+        Expect(kSemicolon);
+        return AddNode(kBreakStatementNode, 0, 0);
+      }
+      case kContinue: {
+        stream_.Consume();
+        Expect(kSemicolon);
+        return AddNode(kContinueStatementNode, 0, 0);
+      }
+      default: {
+        if (detail::IsType(*keyword)) {
+          return ParseDeclaration();
+        }
+        throw UnexpectedToken{};
+      }
+    }
+  }
+  if (IsControl(kOpenBrace)) {
+    return ParseCompoundStatement();
+  }
+  if (IsControl(kSemicolon)) {
+    stream_.Consume();
+    return AddNode(kEmptyNode, 0, 0);
+  }
+  auto expression = ParseExpression();
+  Expect(kSemicolon);
+  return AddNode(kExpressionStatementNode, 0, 0, {expression});
+}
+
+NodeIndex Parser::ParseCompoundStatement() {
+  Expect(kOpenBrace);
+  auto first = kNullNode;
+  auto last = kNullNode;
+  while (!IsControl(kCloseBrace)) {
+    if (IsCompilationUnitEnd()) {
+      throw UnexpectedToken{};
+    }
+    AppendChild(first, last, ParseStatement());
+  }
+  stream_.Consume();
+  return ast_.AddNode(Node{kCompoundStatementNode, 0, 0, first, kNullNode});
+}
+
+NodeIndex Parser::ParseDeclaration() {
+  auto type = ExpectType();
+  auto first = kNullNode;
+  auto last = kNullNode;
+  while (true) {
+    auto name = ExpectIdentifier();
+    if (IsControl(kEqual)) {
+      stream_.Consume();
+      auto initializer = ParseExpression();
+      AppendChild(first, last, AddNode(kDeclaratorNode, 0, name, {initializer}));
+    } else {
+      AppendChild(first, last, AddNode(kDeclaratorNode, 0, name));
+    }
+    if (!IsControl(kComma)) {
+      break;
+    }
+    stream_.Consume();
+  }
+  Expect(kSemicolon);
+  return ast_.AddNode(Node{kDeclarationNode, type, 0, first, kNullNode});
+}
+
+NodeIndex Parser::ParseIfStatement() {
+  struct Branch {
+    NodeIndex condition;
+    NodeIndex then;
+  };
+
+  // An `else if` chain is flat in the source, so it is parsed by a loop and
+  // does not count against the nesting limit. The tree still nests it.
+  std::vector<Branch> branches{};
+  auto otherwise = kNullNode;
+  while (true) {
+    Expect(kIf);
+    Expect(kOpenBracket);
+    auto condition = ParseExpression();
+    Expect(kCloseBracket);
+    branches.push_back({condition, ParseStatement()});
+    if (!IsKeyword(kElse)) {
+      break;
+    }
+    stream_.Consume();
+    if (!IsKeyword(kIf)) {
+      otherwise = ParseStatement();
+      break;
+    }
+  }
+
+  auto statement = otherwise;
+  for (auto branch = branches.rbegin(); branch != branches.rend(); ++branch) {
+    statement = statement == kNullNode
+                  ? AddNode(kIfStatementNode, 0, 0, {branch->condition, branch->then})
+                  : AddNode(kIfStatementNode, 0, 0, {branch->condition, branch->then, statement});
+  }
+  return statement;
+}
+
+NodeIndex Parser::ParseForStatement() {
+  Expect(kFor);
+  Expect(kOpenBracket);
+
+  NodeIndex init{};
+  if (IsType()) {
+    init = ParseDeclaration();
+  } else if (IsControl(kSemicolon)) {
+    stream_.Consume();
+    init = AddNode(kEmptyNode, 0, 0);
+  } else {
+    init = ParseExpression();
+    Expect(kSemicolon);
+  }
+
+  auto condition = IsControl(kSemicolon) ? AddNode(kEmptyNode, 0, 0) : ParseExpression();
+  Expect(kSemicolon);
+
+  auto step = IsControl(kCloseBracket) ? AddNode(kEmptyNode, 0, 0) : ParseExpression();
+  Expect(kCloseBracket);
+
+  auto body = ParseStatement();
+  return AddNode(kForStatementNode, 0, 0, {init, condition, step, body});
+}
+
+NodeIndex Parser::ParseWhileStatement() {
+  Expect(kWhile);
+  Expect(kOpenBracket);
+  auto condition = ParseExpression();
+  Expect(kCloseBracket);
+  auto body = ParseStatement();
+  return AddNode(kWhileStatementNode, 0, 0, {condition, body});
+}
+
+NodeIndex Parser::ParseReturnStatement() {
+  Expect(kReturn);
+  if (IsControl(kSemicolon)) {
+    stream_.Consume();
+    return AddNode(kReturnStatementNode, 0, 0);
+  }
+  auto value = ParseExpression();
+  Expect(kSemicolon);
+  return AddNode(kReturnStatementNode, 0, 0, {value});
+}
+
+NodeIndex Parser::ParseExpression() {
+  NestingGuard guard{depth_};
+  auto target = ParseBinaryExpression(1);
+  auto control = PeekControl();
+  if (!control || !detail::IsAssignment(*control)) {
+    return target;
+  }
+  stream_.Consume();
+  // Assignments are right-associative.
+  auto value = ParseExpression();
+  return AddNode(kAssignmentExpressionNode, *control, 0, {target, value});
+}
+
+NodeIndex Parser::ParseBinaryExpression(int minimal_precedence) {
+  auto left = ParseUnaryExpression();
+  while (true) {
+    auto control = PeekControl();
+    if (!control) {
+      return left;
+    }
+    auto precedence = detail::GetBinaryPrecedence(*control);
+    if (precedence < minimal_precedence || precedence == 0) {
+      return left;
+    }
+    stream_.Consume();
+    auto right = ParseBinaryExpression(precedence + 1);
+    left = AddNode(kBinaryExpressionNode, *control, 0, {left, right});
+  }
+}
+
+NodeIndex Parser::ParseUnaryExpression() {
+  NestingGuard guard{depth_};
+  auto control = PeekControl();
+  if (!control || !detail::IsUnary(*control)) {
+    return ParsePostfixExpression();
+  }
+  stream_.Consume();
+  auto operand = ParseUnaryExpression();
+  return AddNode(kUnaryExpressionNode, *control, 0, {operand});
+}
+
+NodeIndex Parser::ParsePostfixExpression() {
+  auto operand = ParsePrimaryExpression();
+  while (auto control = PeekControl()) {
+    if (*control == kPlusPlus || *control == kMinusMinus) {
+      stream_.Consume();
+      operand = AddNode(kPostfixExpressionNode, *control, 0, {operand});
+    } else if (*control == kOpenBracket) {
+      stream_.Consume();
+      auto first = operand;
+      auto last = operand;
+      if (!IsControl(kCloseBracket)) {
+        while (true) {
+          AppendChild(first, last, ParseExpression());
+          if (!IsControl(kComma)) {
+            break;
+          }
+          stream_.Consume();
+        }
+      }
+      Expect(kCloseBracket);
+      operand = ast_.AddNode(Node{kCallExpressionNode, 0, 0, first, kNullNode});
+    } else if (*control == kOpenSquareBracket) {
+      stream_.Consume();
+      auto index = ParseExpression();
+      Expect(kCloseSquareBracket);
+      operand = AddNode(kSubscriptExpressionNode, 0, 0, {operand, index});
+    } else {
+      break;
+    }
+  }
+  return operand;
+}
+
+NodeIndex Parser::ParsePrimaryExpression() {
+  if (IsControl(kOpenBracket)) {
+    stream_.Consume();
+    auto expression = ParseExpression();
+    Expect(kCloseBracket);
+    return expression;
+  }
+
+  auto node = kNullNode;
+  stream_.Peek().Match(
+    [&](const Identifier& identifier) {
+      node = AddNode(kIdentifierNode, 0, Intern(identifier.value));
+    },
+    [&](NumericLiteral literal) {
+      node = AddNode(kNumericLiteralNode, 0, static_cast<std::uint32_t>(literal.value));
+    },
+    [&](CharacterLiteral literal) {
+      node = AddNode(kCharacterLiteralNode, 0, static_cast<unsigned char>(literal.value));
+    },
+    [&](const StringLiteral& literal) {
+      node = AddNode(kStringLiteralNode, 0, ast_.AddSymbol(literal.value));
+    },
+    [](const auto&) {
+    }
+  );
+  if (node == kNullNode) {
+    throw UnexpectedToken{};
+  }
+  stream_.Consume();
+  return node;
+}
+
+}  // namespace compiler
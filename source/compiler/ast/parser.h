@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <compiler/ast/ast.h>
+
+#include <compiler/token/token.h>
+#include <compiler/token/token_stream.h>
+
+namespace compiler {
+
+class UnexpectedToken final : public std::exception {
+ public:
+  const char* what() const noexcept override;
+};
+
+class NestingTooDeep final : public std::exception {
+ public:
+  const char* what() const noexcept override;
+};
+
+/// @brief A recursive-descent parser of a C subset: function definitions and
+/// global declarations of scalar types, compound, `if`/`else`, `for`,
+/// `while`, `return`, `break`, `continue` and expression statements, and
+/// expressions with assignments, binary, unary, postfix operators and calls.
+///
+/// Nesting of statements and expressions is limited to `kMaxNestingDepth`
+/// recursive calls, a parenthesized expression takes two of them. Deeper
+/// input throws `NestingTooDeep` instead of exhausting the stack.
+class Parser final {
+ public:
+  static constexpr std::size_t kMaxNestingDepth = 256;
+
+ public:
+  /// @brief Creates a parser appending nodes to `ast`.
+  Parser(TokenStream& stream, Ast& ast) noexcept;
+
+  /// @return The translation unit node.
+  NodeIndex ParseTranslationUnit();
+
+ private:
+  std::optional<Control> PeekControl(std::size_t k = 0);
+
+  std::optional<Keyword> PeekKeyword(std::size_t k = 0);
+
+  bool IsControl(Control control, std::size_t k = 0);
+
+  bool IsKeyword(Keyword keyword, std::size_t k = 0);
+
+  bool IsType(std::size_t k = 0);
+
+  bool IsCompilationUnitEnd();
+
+  void Expect(Control control);
+
+  void Expect(Keyword keyword);
+
+  Keyword ExpectType();
+
+  std::uint32_t ExpectIdentifier();
+
+  std::uint32_t Intern(const std::string& symbol);
+
+  NodeIndex AddNode(NodeKind kind,
+                    std::uint8_t operation,
+                    std::uint32_t value,
+                    std::initializer_list<NodeIndex> children = {});
+
+  /// @brief Appends `child` to a sibling list given by its `first` and `last` nodes.
+  void AppendChild(NodeIndex& first, NodeIndex& last, NodeIndex child) noexcept;
+
+ private:
+  /// @brief Counts a level of recursion for the lifetime of the guard.
+  class NestingGuard final {
+   public:
+    NestingGuard(std::size_t& depth);
+
+    NestingGuard(const NestingGuard&) = delete;
+    NestingGuard& operator=(const NestingGuard&) = delete;
+
+    ~NestingGuard() noexcept;
+
+   private:
+    std::size_t& depth_;
+  };
+
+ private:
+  NodeIndex ParseExternalDeclaration();
+
+  NodeIndex ParseFunctionDefinition();
+
+  NodeIndex ParseParameterList();
+
+  NodeIndex ParseStatement();
+
+  NodeIndex ParseCompoundStatement();
+
+  NodeIndex ParseDeclaration();
+
+  NodeIndex ParseIfStatement();
+
+  NodeIndex ParseForStatement();
+
+  NodeIndex ParseWhileStatement();
+
+  NodeIndex ParseReturnStatement();
+
+  NodeIndex ParseExpression();
+
+  NodeIndex ParseBinaryExpression(int minimal_precedence);
+
+  NodeIndex ParseUnaryExpression();
+
+  NodeIndex ParsePostfixExpression();
+
+  NodeIndex ParsePrimaryExpression();
+
+ private:
+  TokenStream& stream_;
+  Ast& ast_;
+  std::unordered_map<std::string, std::uint32_t> symbols_;
+  std::size_t depth_;
+};
+
+}  // namespace compiler
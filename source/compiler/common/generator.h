@@ -0,0 +1,97 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace compiler {
+
+/// @brief A lazily evaluated sequence produced by a coroutine.
+///
+/// The coroutine runs only inside `Next` up to its next `co_yield`, so values
+/// are computed on demand, one at a time.
+template <typename T>
+class Generator final {
+ public:
+  struct promise_type {
+    std::optional<T> value;
+    std::exception_ptr error;
+
+    Generator get_return_object() noexcept {
+      return Generator{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+
+    std::suspend_always initial_suspend() noexcept {
+      return {};
+    }
+
+    std::suspend_always final_suspend() noexcept {
+      return {};
+    }
+
+    std::suspend_always yield_value(T yielded) {
+      value.emplace(std::move(yielded));
+      return {};
+    }
+
+    void return_void() noexcept {
+    }
+
+    void unhandled_exception() noexcept {
+      error = std::current_exception();
+    }
+  };
+
+ public:
+  Generator(Generator&& other) noexcept
+    : handle_{std::exchange(other.handle_, nullptr)} {
+  }
+
+  Generator& operator=(Generator&& other) noexcept {
+    if (this != &other) {
+      Destroy();
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+
+  ~Generator() noexcept {
+    Destroy();
+  }
+
+  /// @brief Resumes the coroutine up to the next value.
+  ///
+  /// @return `std::nullopt` once the coroutine has finished. An exception
+  /// escaped the coroutine is rethrown once, then the sequence is over.
+  std::optional<T> Next() {
+    if (!handle_ || handle_.done()) {
+      return std::nullopt;
+    }
+    handle_.resume();
+    auto& promise = handle_.promise();
+    if (promise.error) {
+      std::rethrow_exception(std::exchange(promise.error, nullptr));
+    }
+    if (handle_.done()) {
+      return std::nullopt;
+    }
+    return std::exchange(promise.value, std::nullopt);
+  }
+
+ private:
+  explicit Generator(std::coroutine_handle<promise_type> handle) noexcept
+    : handle_{handle} {
+  }
+
+  void Destroy() noexcept {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+ private:
+  std::coroutine_handle<promise_type> handle_;
+};
+
+}  // namespace compiler
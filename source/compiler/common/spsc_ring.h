@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+
+namespace compiler {
+
+/// @brief A bounded lock-free ring for exactly one producer and one consumer
+/// thread.
+///
+/// Indices grow monotonically and are masked on access, so the ring holds
+/// up to `Capacity` elements. Each index is written by a single side only and
+/// lives on its own cache line to avoid false sharing. The blocking `Push` and
+/// `Pop` spin for a bounded number of checks and then sleep on the index the
+/// other side advances.
+template <typename T, std::size_t Capacity>
+class SpscRing final {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "capacity must be a power of two");
+
+ public:
+  SpscRing() noexcept = default;
+
+  SpscRing(const SpscRing&) = delete;
+  SpscRing& operator=(const SpscRing&) = delete;
+
+  /// @brief Producer side.
+  ///
+  /// @return `false` if the ring is full.
+  bool TryPush(T value) noexcept {
+    auto tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == Capacity) {
+      return false;
+    }
+    slots_[tail & (Capacity - 1)] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    tail_.notify_one();
+    return true;
+  }
+
+  /// @brief Producer side, waits while the ring is full.
+  void Push(T value) noexcept {
+    auto tail = tail_.load(std::memory_order_relaxed);
+    Await(head_, [tail](std::size_t head) {
+      return tail - head != Capacity;
+    });
+    slots_[tail & (Capacity - 1)] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    tail_.notify_one();
+  }
+
+  /// @brief Consumer side.
+  ///
+  /// @return `std::nullopt` if the ring is empty.
+  std::optional<T> TryPop() noexcept {
+    auto head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return std::nullopt;
+    }
+    T value = slots_[head & (Capacity - 1)];
+    head_.store(head + 1, std::memory_order_release);
+    head_.notify_one();
+    return value;
+  }
+
+  /// @brief Consumer side, waits while the ring is empty.
+  T Pop() noexcept {
+    auto head = head_.load(std::memory_order_relaxed);
+    Await(tail_, [head](std::size_t tail) {
+      return tail != head;
+    });
+    T value = slots_[head & (Capacity - 1)];
+    head_.store(head + 1, std::memory_order_release);
+    head_.notify_one();
+    return value;
+  }
+
+ private:
+  /// @brief Waits until `ready` accepts the value of an index owned by the other side.
+  template <typename TReady>
+  static void Await(const std::atomic<std::size_t>& index, TReady ready) noexcept {
+    auto value = index.load(std::memory_order_acquire);
+    for (std::size_t spin = 0; !ready(value); ++spin) {
+      if (spin >= kSpinCount) {
+        index.wait(value, std::memory_order_acquire);
+      }
+      value = index.load(std::memory_order_acquire);
+    }
+  }
+
+ private:
+  static constexpr std::size_t kCacheLineSize = 64;
+  static constexpr std::size_t kSpinCount = 128;
+
+ private:
+  alignas(kCacheLineSize) std::atomic<std::size_t> head_{0};
+  alignas(kCacheLineSize) std::atomic<std::size_t> tail_{0};
+  alignas(kCacheLineSize) std::array<T, Capacity> slots_{};
+};
+
+}  // namespace compiler
@@ -0,0 +1,29 @@
+#include <compiler/io/source_buffer.h>
+
+namespace compiler {
+
+SourceBuffer::SourceBuffer(std::string_view buffer) noexcept
+  : buffer_{buffer}
+  , cursor_{} {
+}
+
+void SourceBuffer::Advance() noexcept {
+  if (cursor_ < buffer_.size()) {
+    ++cursor_;
+  }
+}
+
+char SourceBuffer::Peek() const noexcept {
+  if (cursor_ < buffer_.size()) {
+    return buffer_[cursor_];
+  }
+  return '\0';
+}
+
+char SourceBuffer::Read() noexcept {
+  auto character = Peek();
+  Advance();
+  return character;
+}
+
+}  // namespace compiler
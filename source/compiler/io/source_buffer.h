@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include <compiler/io/reader.h>
+
+namespace compiler {
+
+/// @brief A reader over an in-memory buffer, e.g. one received from a client.
+///
+/// The reader does not own the buffer, it must outlive the reader.
+class SourceBuffer final : public IReader {
+ public:
+  SourceBuffer(std::string_view buffer) noexcept;
+
+  void Advance() noexcept override;
+
+  char Peek() const noexcept override;
+
+  char Read() noexcept override;
+
+ private:
+  std::string_view buffer_;
+  std::size_t cursor_;
+};
+
+}  // namespace compiler
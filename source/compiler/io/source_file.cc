@@ -2,15 +2,26 @@
 
 #include <compiler/io/source_file.h>
 
+#include <compiler/trace/trace.h>
+
 namespace compiler {
 
+const char* UnableToOpenFile::what() const noexcept {
+  return "unable to open file";
+}
+
 SourceFile::SourceFile(const char* file_name)
   : buffer_{}
   , cursor_{} {
+  TraceScope scope{"load", file_name};
   std::ifstream stream{file_name};
+  if (!stream.is_open()) {
+    throw UnableToOpenFile{};
+  }
   while (stream.peek(), !stream.eof()) {
     buffer_.push_back(stream.get());
   }
+  scope.SetByteCount(buffer_.size());
 }
 
 void SourceFile::Advance() noexcept {
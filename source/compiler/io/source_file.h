@@ -1,11 +1,17 @@
 #pragma once
 
+#include <exception>
 #include <string>
 
 #include <compiler/io/reader.h>
 
 namespace compiler {
 
+class UnableToOpenFile final : public std::exception {
+ public:
+  const char* what() const noexcept override;
+};
+
 class SourceFile final : public IReader {
  public:
   SourceFile(const char* file_name);
@@ -1,41 +1,235 @@
+#include <algorithm>
+#include <array>
+#include <csignal>
+#include <cstring>
+#include <exception>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <pthread.h>
+
+#include <compiler/ast/ast.h>
+#include <compiler/ast/ast_writer.h>
+#include <compiler/ast/parser.h>
 
 #include <compiler/io/source_file.h>
 
+#include <compiler/server/client.h>
+#include <compiler/server/server.h>
+
+#include <compiler/token/keyword_table.h>
+#include <compiler/token/pipelined_tokenizer.h>
+#include <compiler/token/token_stream.h>
+#include <compiler/token/token_writer.h>
 #include <compiler/token/tokenizer.h>
 
-int main() {
-  compiler::SourceFile source_file{"test.txt"};
-
-  compiler::Tokenizer tokenizer{source_file};
-
-  bool compilation_unit_found{false};
-  while (!compilation_unit_found) {
-    auto token = tokenizer.Tokenize();
-    token.Match(
-      [&](compiler::CompilationUnitEnd) {
-        compilation_unit_found = true;
-      },
-      [](compiler::Keyword keyword) {
-        std::cout << "keyword: " << keyword << std::endl;
-      },
-      [](compiler::Control control) {
-        std::cout << "control: " << control << std::endl;
-      },
-      [](compiler::CharacterLiteral literal) {
-        std::cout << "character literal: '" << literal.value << "'" << std::endl;
-      },
-      [](compiler::NumericLiteral literal) {
-        std::cout << "numeric literal: " << literal.value << std::endl;
-      },
-      [](const compiler::StringLiteral& literal) {
-        std::cout << "string literal: '" << literal.value << "'" << std::endl;
-      },
-      [](const compiler::Identifier& identifier) {
-        std::cout << "identifier: '" << identifier.value << "'" << std::endl;
-      }
-    );
+#include <compiler/trace/trace.h>
+
+namespace {
+
+/// @brief Forwards output to `stream` in fixed-size chunks, each of them is
+/// traced as an "emit" span, so emission interleaves with lexing.
+class EmittingStreambuf final : public std::streambuf {
+ public:
+  EmittingStreambuf(std::ostream& stream, std::string_view file_name) noexcept
+    : stream_{stream}
+    , file_name_{file_name}
+    , buffer_{} {
+    setp(buffer_.data(), buffer_.data() + buffer_.size());
+  }
+
+  ~EmittingStreambuf() noexcept override {
+    sync();
+  }
+
+ protected:
+  int_type overflow(int_type character) override {
+    if (sync() != 0) {
+      return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(character, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(character);
+      pbump(1);
+    }
+    return traits_type::not_eof(character);
+  }
+
+  int sync() override {
+    auto size = static_cast<std::size_t>(pptr() - pbase());
+    if (size == 0) {
+      return 0;
+    }
+    compiler::TraceScope scope{"emit", file_name_};
+    scope.SetByteCount(size);
+    stream_.write(pbase(), static_cast<std::streamsize>(size)).flush();
+    setp(buffer_.data(), buffer_.data() + buffer_.size());
+    return stream_ ? 0 : -1;
+  }
+
+ private:
+  static constexpr std::size_t kChunkSize = 64 * 1024;
+
+ private:
+  std::ostream& stream_;
+  std::string_view file_name_;
+  std::array<char, kChunkSize> buffer_;
+};
+
+int RunServer(const char* socket_path) {
+  // Turns SIGINT and SIGTERM into a graceful stop, so the socket is removed
+  // and the trace is written.
+  sigset_t signals{};
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+  compiler::Server server{socket_path, std::max(1u, std::thread::hardware_concurrency())};
+  std::thread stopper{[&] {
+    int signal{};
+    sigwait(&signals, &signal);
+    server.Stop();
+  }};
+
+  std::exception_ptr error{};
+  try {
+    server.Run();
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  // Wakes the stopper up if `Run` returned on its own; a thread-directed
+  // signal is dropped if the stopper has already finished.
+  pthread_kill(stopper.native_handle(), SIGTERM);
+  stopper.join();
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return 0;
+}
+
+int RunClient(const char* socket_path, int argc, char** argv) {
+  compiler::Client client{socket_path};
+  int status{};
+  for (int index = 0; index < argc; ++index) {
+    compiler::LexResponse response{};
+    if (std::strcmp(argv[index], "-") == 0) {
+      std::string buffer{std::istreambuf_iterator<char>{std::cin}, std::istreambuf_iterator<char>{}};
+      response = client.LexBuffer(buffer);
+    } else {
+      response = client.LexFile(argv[index]);
+    }
+    std::cout << response.tokens;
+    if (response.error) {
+      std::cout << "ERROR " << *response.error << '\n';
+      status = 1;
+    } else {
+      std::cout << "END\n";
+    }
+  }
+  return status;
+}
+
+int RunLocal(const char* file_name, bool pipelined) {
+  compiler::SourceFile source_file{file_name};
+
+  compiler::KeywordTable keyword_table{};
+
+  // Tokens lexed before an error are still written.
+  EmittingStreambuf output{std::cout, file_name};
+  std::ostream stream{&output};
+
+  compiler::TraceScope scope{"lex", file_name};
+  if (pipelined) {
+    compiler::PipelinedTokenizer tokenizer{source_file, keyword_table};
+    scope.SetTokenCount(compiler::WriteTokens(tokenizer, stream));
+  } else {
+    compiler::Tokenizer tokenizer{source_file, keyword_table};
+    scope.SetTokenCount(compiler::WriteTokens(tokenizer, stream));
+  }
+  return 0;
+}
+
+int RunParse(const char* file_name) {
+  compiler::SourceFile source_file{file_name};
+
+  compiler::KeywordTable keyword_table{};
+  compiler::TokenStream stream{compiler::GenerateTokens(source_file, keyword_table)};
+
+  compiler::Ast ast{};
+  compiler::NodeIndex root{};
+  {
+    compiler::TraceScope scope{"parse", file_name};
+    compiler::Parser parser{stream, ast};
+    root = parser.ParseTranslationUnit();
+    scope.SetByteCount(ast.GetMemoryUsage());
   }
 
+  compiler::WriteAst(ast, root, std::cout);
+  std::cout << std::flush;
   return 0;
-}
\ No newline at end of file
+}
+
+}  // namespace
+
+/// Usage:
+///   compiler.out [options] [file]                       lexes `file`, "test.txt" by default
+///   compiler.out [options] --server <socket>            serves lexing requests on `socket`
+///   compiler.out [options] --client <socket> <file>...  lexes files via the server, "-" is stdin
+/// Options:
+///   --trace <output>  writes a Chrome trace-event timeline of the run to `output`
+///   --pipelined       lexes on a separate thread, overlapping it with emission
+///   --parse           writes the syntax tree instead of tokens
+int main(int argc, char** argv) {
+  const char* trace_file_name{nullptr};
+  bool pipelined{false};
+  bool parse{false};
+  while (argc >= 2) {
+    if (argc >= 3 && std::strcmp(argv[1], "--trace") == 0) {
+      trace_file_name = argv[2];
+      compiler::EnableTracing();
+      argc -= 2;
+      argv += 2;
+    } else if (std::strcmp(argv[1], "--pipelined") == 0) {
+      pipelined = true;
+      argc -= 1;
+      argv += 1;
+    } else if (std::strcmp(argv[1], "--parse") == 0) {
+      parse = true;
+      argc -= 1;
+      argv += 1;
+    } else {
+      break;
+    }
+  }
+
+  int status{};
+  try {
+    if (argc >= 3 && std::strcmp(argv[1], "--server") == 0) {
+      status = RunServer(argv[2]);
+    } else if (argc >= 3 && std::strcmp(argv[1], "--client") == 0) {
+      status = RunClient(argv[2], argc - 3, argv + 3);
+    } else if (parse) {
+      status = RunParse(argc >= 2 ? argv[1] : "test.txt");
+    } else {
+      status = RunLocal(argc >= 2 ? argv[1] : "test.txt", pipelined);
+    }
+  } catch (const std::exception& exception) {
+    std::cout << std::flush;
+    std::cerr << "error: " << exception.what() << std::endl;
+    status = 1;
+  }
+
+  // Written on failures too, the timeline shows where the run stopped.
+  if (trace_file_name != nullptr) {
+    std::ofstream trace_file{trace_file_name};
+    compiler::WriteTrace(trace_file);
+  }
+
+  return status;
+}
@@ -0,0 +1,53 @@
+#include <filesystem>
+#include <string_view>
+
+#include <compiler/server/client.h>
+
+#include <compiler/trace/trace.h>
+
+namespace compiler {
+
+Client::Client(const char* socket_path)
+  : connection_{ConnectUnixSocket(socket_path)} {
+}
+
+LexResponse Client::LexFile(const std::string& file_name) {
+  // The server resolves relative paths against its own working directory.
+  auto path = std::filesystem::absolute(file_name).string();
+  TraceScope scope{"request", path};
+  connection_.Write("FILE " + path + "\n");
+  return ReceiveResponse();
+}
+
+LexResponse Client::LexBuffer(std::string_view buffer) {
+  TraceScope scope{"request", "<buffer>"};
+  scope.SetByteCount(buffer.size());
+  connection_.Write("BUFFER " + std::to_string(buffer.size()) + "\n");
+  connection_.Write(buffer);
+  return ReceiveResponse();
+}
+
+LexResponse Client::ReceiveResponse() {
+  static constexpr std::string_view kTokensResponse = "TOKENS ";
+  static constexpr std::string_view kErrorResponse = "ERROR ";
+
+  auto header = connection_.ReadLine();
+  if (!header || !header->starts_with(kTokensResponse)) {
+    throw ProtocolError{};
+  }
+  auto size = detail::ParseSize(std::string_view{*header}.substr(kTokensResponse.size()));
+
+  LexResponse response{connection_.ReadExactly(size), std::nullopt};
+  auto status = connection_.ReadLine();
+  if (!status) {
+    throw ProtocolError{};
+  }
+  if (status->starts_with(kErrorResponse)) {
+    response.error = status->substr(kErrorResponse.size());
+  } else if (*status != "END") {
+    throw ProtocolError{};
+  }
+  return response;
+}
+
+}  // namespace compiler
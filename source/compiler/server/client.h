@@ -0,0 +1,35 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <compiler/server/connection.h>
+
+namespace compiler {
+
+/// @brief A response of `Server` to a single request.
+struct LexResponse {
+  /// Token lines lexed before the end of the unit or the error.
+  std::string tokens;
+  /// What the server reported on a failure, `std::nullopt` on success.
+  std::optional<std::string> error;
+};
+
+/// @brief A client of `Server`, one request is in flight at a time.
+class Client final {
+ public:
+  Client(const char* socket_path);
+
+  LexResponse LexFile(const std::string& file_name);
+
+  LexResponse LexBuffer(std::string_view buffer);
+
+ private:
+  LexResponse ReceiveResponse();
+
+ private:
+  Connection connection_;
+};
+
+}  // namespace compiler
@@ -0,0 +1,192 @@
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <compiler/server/connection.h>
+
+namespace compiler::detail {
+
+sockaddr_un MakeUnixAddress(const char* socket_path) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (std::strlen(socket_path) >= sizeof(address.sun_path)) {
+    throw SocketError{};
+  }
+  std::strcpy(address.sun_path, socket_path);
+  return address;
+}
+
+void RemoveStaleSocket(const char* socket_path) {
+  struct stat status{};
+  if (::lstat(socket_path, &status) < 0) {
+    if (errno == ENOENT) {
+      return;
+    }
+    throw SocketError{};
+  }
+  // Only a socket nobody listens on any more is left over by a previous server,
+  // anything else at the path belongs to someone else.
+  if (!S_ISSOCK(status.st_mode)) {
+    throw SocketError{};
+  }
+  auto address = MakeUnixAddress(socket_path);
+  int descriptor = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (descriptor < 0) {
+    throw SocketError{};
+  }
+  auto connected = ::connect(descriptor, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+  auto error = errno;
+  ::close(descriptor);
+  if (connected == 0 || error != ECONNREFUSED || ::unlink(socket_path) < 0) {
+    throw SocketError{};
+  }
+}
+
+std::size_t ParseSize(std::string_view string) {
+  if (string.empty()) {
+    throw ProtocolError{};
+  }
+  std::size_t size{};
+  for (auto character : string) {
+    if (character < '0' || character > '9') {
+      throw ProtocolError{};
+    }
+    auto digit = static_cast<std::size_t>(character - '0');
+    if (size > (std::numeric_limits<std::size_t>::max() - digit) / 10) {
+      throw ProtocolError{};
+    }
+    size = size * 10 + digit;
+  }
+  return size;
+}
+
+}  // namespace compiler::detail
+
+namespace compiler {
+
+const char* SocketError::what() const noexcept {
+  return "socket operation failed";
+}
+
+const char* ProtocolError::what() const noexcept {
+  return "protocol violation";
+}
+
+int ListenUnixSocket(const char* socket_path) {
+  auto address = detail::MakeUnixAddress(socket_path);
+  detail::RemoveStaleSocket(socket_path);
+  int descriptor = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (descriptor < 0) {
+    throw SocketError{};
+  }
+  if (::bind(descriptor, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+      ::listen(descriptor, SOMAXCONN) < 0) {
+    ::close(descriptor);
+    throw SocketError{};
+  }
+  return descriptor;
+}
+
+int ConnectUnixSocket(const char* socket_path) {
+  auto address = detail::MakeUnixAddress(socket_path);
+  int descriptor = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (descriptor < 0) {
+    throw SocketError{};
+  }
+  if (::connect(descriptor, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+    ::close(descriptor);
+    throw SocketError{};
+  }
+  return descriptor;
+}
+
+Connection::Connection(int descriptor) noexcept
+  : descriptor_{descriptor}
+  , buffer_{}
+  , cursor_{} {
+}
+
+Connection::~Connection() noexcept {
+  ::close(descriptor_);
+}
+
+std::optional<std::string> Connection::ReadLine() {
+  std::size_t scanned{};
+  while (true) {
+    auto end = buffer_.find('\n', cursor_ + scanned);
+    if (end != std::string::npos) {
+      std::string line = buffer_.substr(cursor_, end - cursor_);
+      cursor_ = end + 1;
+      return line;
+    }
+    scanned = buffer_.size() - cursor_;
+    if (!Fill()) {
+      if (cursor_ != buffer_.size()) {
+        throw ProtocolError{};
+      }
+      return std::nullopt;
+    }
+  }
+}
+
+std::string Connection::ReadExactly(std::size_t size) {
+  while (buffer_.size() - cursor_ < size) {
+    if (!Fill()) {
+      throw ProtocolError{};
+    }
+  }
+  std::string data = buffer_.substr(cursor_, size);
+  cursor_ += size;
+  return data;
+}
+
+void Connection::Write(std::string_view data) {
+  while (!data.empty()) {
+    auto written = ::send(descriptor_, data.data(), data.size(), MSG_NOSIGNAL);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw SocketError{};
+    }
+    data.remove_prefix(static_cast<std::size_t>(written));
+  }
+}
+
+bool Connection::HasBufferedData() const noexcept {
+  return cursor_ < buffer_.size();
+}
+
+int Connection::GetDescriptor() const noexcept {
+  return descriptor_;
+}
+
+bool Connection::Fill() {
+  static constexpr std::size_t kChunkSize = 64 * 1024;
+
+  // Drop the consumed prefix so a long-lived connection does not grow without bound.
+  buffer_.erase(0, cursor_);
+  cursor_ = 0;
+
+  auto size = buffer_.size();
+  buffer_.resize(size + kChunkSize);
+  while (true) {
+    auto received = ::recv(descriptor_, buffer_.data() + size, kChunkSize, 0);
+    if (received < 0 && errno == EINTR) {
+      continue;
+    }
+    if (received < 0) {
+      buffer_.resize(size);
+      throw SocketError{};
+    }
+    buffer_.resize(size + static_cast<std::size_t>(received));
+    return received > 0;
+  }
+}
+
+}  // namespace compiler
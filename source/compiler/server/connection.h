@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace compiler {
+
+class SocketError final : public std::exception {
+ public:
+  const char* what() const noexcept override;
+};
+
+class ProtocolError final : public std::exception {
+ public:
+  const char* what() const noexcept override;
+};
+
+/// @brief Opens a listening unix domain socket bound to `socket_path`.
+///
+/// A socket left at `socket_path` by a server that is gone is replaced. Throws
+/// `SocketError` if the path is taken by anything else, a live socket included.
+int ListenUnixSocket(const char* socket_path);
+
+/// @brief Connects to a unix domain socket bound to `socket_path`.
+int ConnectUnixSocket(const char* socket_path);
+
+/// @brief An owning wrapper over a connected stream socket with buffered reads.
+class Connection final {
+ public:
+  Connection(int descriptor) noexcept;
+
+  Connection(const Connection&) = delete;
+  Connection& operator=(const Connection&) = delete;
+
+  ~Connection() noexcept;
+
+  /// @brief Reads a line without the trailing '\n'.
+  ///
+  /// @return `std::nullopt` if the peer has closed the connection.
+  std::optional<std::string> ReadLine();
+
+  std::string ReadExactly(std::size_t size);
+
+  void Write(std::string_view data);
+
+  /// @return `true` if received bytes are buffered but not read yet.
+  bool HasBufferedData() const noexcept;
+
+  int GetDescriptor() const noexcept;
+
+ private:
+  bool Fill();
+
+ private:
+  int descriptor_;
+  std::string buffer_;
+  std::size_t cursor_;
+};
+
+namespace detail {
+
+/// @brief Parses a decimal size of a protocol header.
+///
+/// Throws `ProtocolError` if `string` is not a number or does not fit `std::size_t`.
+std::size_t ParseSize(std::string_view string);
+
+}  // namespace detail
+
+}  // namespace compiler
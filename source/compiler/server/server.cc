@@ -0,0 +1,284 @@
+#include <cerrno>
+#include <chrono>
+#include <optional>
+#include <sstream>
+#include <string_view>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <compiler/io/source_buffer.h>
+#include <compiler/io/source_file.h>
+
+#include <compiler/server/server.h>
+
+#include <compiler/token/token_writer.h>
+#include <compiler/token/tokenizer.h>
+
+#include <compiler/trace/trace.h>
+
+namespace compiler::detail {
+
+/// @return `true` for errors caused by exhausted resources, which go away
+/// once connections are closed.
+bool IsTransientError(int error) noexcept {
+  return error == EMFILE || error == ENFILE || error == ENOBUFS || error == ENOMEM;
+}
+
+}  // namespace compiler::detail
+
+namespace compiler {
+
+Server::Server(const char* socket_path, std::size_t worker_count)
+  : socket_path_{socket_path}
+  , listener_{ListenUnixSocket(socket_path)}
+  , wake_reader_{-1}
+  , wake_writer_{-1}
+  , worker_count_{worker_count > 0 ? worker_count : 1}
+  , keyword_table_{}
+  , workers_{}
+  , connections_{}
+  , ready_{}
+  , returned_{}
+  , mutex_{}
+  , condition_{}
+  , stopped_{false} {
+  int wake[2]{};
+  // The listener is only accepted from once `poll` reports it, it must not block
+  // if the pending connection is gone by then.
+  if (::fcntl(listener_, F_SETFL, O_NONBLOCK) < 0 || ::pipe2(wake, O_NONBLOCK | O_CLOEXEC) < 0) {
+    ::close(listener_);
+    ::unlink(socket_path_.c_str());
+    throw SocketError{};
+  }
+  wake_reader_ = wake[0];
+  wake_writer_ = wake[1];
+}
+
+Server::~Server() noexcept {
+  ::close(wake_reader_);
+  ::close(wake_writer_);
+  ::close(listener_);
+  ::unlink(socket_path_.c_str());
+}
+
+void Server::Run() {
+  for (std::size_t index = 0; index < worker_count_; ++index) {
+    workers_.emplace_back([this] {
+      Work();
+    });
+  }
+
+  // Connections waiting for their next request, only touched by this thread.
+  std::vector<int> idle{};
+  std::vector<pollfd> descriptors{};
+  // Set while accepting is paused after running out of resources, the
+  // listener stays readable meanwhile and would keep `poll` spinning.
+  std::optional<std::chrono::steady_clock::time_point> accept_resumed_at{};
+  int error{};
+  while (!stopped_.load()) {
+    int timeout{-1};
+    if (accept_resumed_at) {
+      auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+        *accept_resumed_at - std::chrono::steady_clock::now());
+      if (remaining.count() > 0) {
+        timeout = static_cast<int>(remaining.count());
+      } else {
+        accept_resumed_at.reset();
+      }
+    }
+
+    descriptors.clear();
+    // A negative descriptor is ignored by `poll`.
+    descriptors.push_back({accept_resumed_at ? -1 : listener_, POLLIN, 0});
+    descriptors.push_back({wake_reader_, POLLIN, 0});
+    for (auto descriptor : idle) {
+      descriptors.push_back({descriptor, POLLIN, 0});
+    }
+    if (::poll(descriptors.data(), descriptors.size(), timeout) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (detail::IsTransientError(errno)) {
+        std::this_thread::sleep_for(kAcceptPause);
+        continue;
+      }
+      error = errno;
+      break;
+    }
+
+    if (descriptors[1].revents != 0) {
+      char drained[64];
+      while (::read(wake_reader_, drained, sizeof(drained)) > 0) {
+      }
+    }
+
+    std::lock_guard guard{mutex_};
+    idle.clear();
+    for (std::size_t index = 2; index < descriptors.size(); ++index) {
+      if (descriptors[index].revents != 0) {
+        ready_.push(connections_.at(descriptors[index].fd).get());
+        condition_.notify_one();
+      } else {
+        idle.push_back(descriptors[index].fd);
+      }
+    }
+    idle.insert(idle.end(), returned_.begin(), returned_.end());
+    returned_.clear();
+
+    if (descriptors[0].revents != 0) {
+      auto accept_error = Accept(idle);
+      if (detail::IsTransientError(accept_error)) {
+        // Existing connections are still served, the pending ones wait in the backlog.
+        accept_resumed_at = std::chrono::steady_clock::now() + kAcceptPause;
+      } else if (accept_error != 0) {
+        error = accept_error;
+        break;
+      }
+    }
+  }
+
+  {
+    std::lock_guard guard{mutex_};
+    stopped_.store(true);
+    // Covers connections accepted after `Stop` has shut the others down.
+    for (auto& [descriptor, connection] : connections_) {
+      ::shutdown(descriptor, SHUT_RD);
+    }
+    condition_.notify_all();
+  }
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+  returned_.clear();
+  connections_.clear();
+
+  if (error != 0) {
+    throw SocketError{};
+  }
+}
+
+void Server::Stop() noexcept {
+  std::lock_guard guard{mutex_};
+  stopped_.store(true);
+  // Wakes up workers waiting for the rest of a request and makes idle
+  // connections see the end of the stream.
+  for (auto& [descriptor, connection] : connections_) {
+    ::shutdown(descriptor, SHUT_RD);
+  }
+  Wake();
+}
+
+int Server::Accept(std::vector<int>& idle) {
+  while (true) {
+    int descriptor = ::accept4(listener_, nullptr, nullptr, SOCK_CLOEXEC);
+    if (descriptor < 0) {
+      if (errno == EINTR || errno == ECONNABORTED) {
+        continue;
+      }
+      return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : errno;
+    }
+    connections_.emplace(descriptor, std::make_unique<Connection>(descriptor));
+    idle.push_back(descriptor);
+  }
+}
+
+void Server::Wake() noexcept {
+  // A full pipe already guarantees a wake up, so the result is ignored.
+  char byte{};
+  [[maybe_unused]] auto written = ::write(wake_writer_, &byte, sizeof(byte));
+}
+
+void Server::Work() {
+  while (true) {
+    Connection* connection{};
+    {
+      std::unique_lock lock{mutex_};
+      condition_.wait(lock, [this] {
+        return !ready_.empty() || stopped_.load();
+      });
+      if (ready_.empty()) {
+        return;
+      }
+      connection = ready_.front();
+      ready_.pop();
+    }
+
+    bool open{};
+    try {
+      open = Serve(*connection);
+    } catch (const std::exception&) {
+      // The peer is gone or does not speak the protocol, drop the connection.
+    }
+    Release(*connection, open);
+  }
+}
+
+void Server::Release(Connection& connection, bool open) {
+  std::lock_guard guard{mutex_};
+  if (!open) {
+    connections_.erase(connection.GetDescriptor());
+  } else if (connection.HasBufferedData()) {
+    // The next request has already been received, `poll` would not report it.
+    ready_.push(&connection);
+    condition_.notify_one();
+  } else {
+    returned_.push_back(connection.GetDescriptor());
+    Wake();
+  }
+}
+
+bool Server::Serve(Connection& connection) {
+  static constexpr std::string_view kFileRequest = "FILE ";
+  static constexpr std::string_view kBufferRequest = "BUFFER ";
+
+  auto request = connection.ReadLine();
+  if (!request) {
+    return false;
+  }
+
+  std::ostringstream stream{};
+  std::string status{"END\n"};
+  std::string_view file_name{"<buffer>"};
+  try {
+    std::string_view line{*request};
+    if (line.starts_with(kFileRequest)) {
+      file_name = line.substr(kFileRequest.size());
+      SourceFile source_file{request->c_str() + kFileRequest.size()};
+      Lex(source_file, file_name, stream);
+    } else if (line.starts_with(kBufferRequest)) {
+      auto size = detail::ParseSize(line.substr(kBufferRequest.size()));
+      auto buffer = connection.ReadExactly(size);
+      SourceBuffer source_buffer{buffer};
+      Lex(source_buffer, file_name, stream);
+    } else {
+      throw ProtocolError{};
+    }
+  } catch (const SocketError&) {
+    throw;
+  } catch (const ProtocolError&) {
+    // Where the next request begins is unknown, e.g. a rejected body would be
+    // read as request lines, so the connection is dropped instead of answered.
+    throw;
+  } catch (const std::exception& exception) {
+    status = std::string{"ERROR "} + exception.what() + "\n";
+  }
+  auto tokens = stream.view();
+  TraceScope scope{"emit", file_name};
+  scope.SetByteCount(tokens.size());
+  connection.Write("TOKENS " + std::to_string(tokens.size()) + "\n");
+  connection.Write(tokens);
+  connection.Write(status);
+  return true;
+}
+
+void Server::Lex(IReader& reader, std::string_view file_name, std::ostream& stream) {
+  TraceScope scope{"lex", file_name};
+  Tokenizer tokenizer{reader, keyword_table_};
+  scope.SetTokenCount(WriteTokens(tokenizer, stream));
+}
+
+}  // namespace compiler
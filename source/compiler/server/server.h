@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <compiler/io/reader.h>
+
+#include <compiler/server/connection.h>
+
+#include <compiler/token/keyword_table.h>
+
+namespace compiler {
+
+/// @brief A long-lived lexing server listening on a unix domain socket.
+///
+/// A connection carries a sequence of requests, each of them is either
+///   "FILE <path>\n" or
+///   "BUFFER <size>\n" followed by exactly <size> bytes.
+/// Every request is answered with "TOKENS <size>\n" followed by <size> bytes
+/// of token lines, as printed by `WriteTokens`, and then by either "END\n" or
+/// "ERROR <what>\n". Tokens lexed before an error are still sent. A request
+/// that violates the protocol closes the connection without a response.
+///
+/// The keyword table and worker threads live as long as the server does, so
+/// they are paid for once instead of once per compilation unit. Idle
+/// connections are polled by the thread calling `Run`, a worker is only taken
+/// for the duration of a single request.
+class Server final {
+ public:
+  Server(const char* socket_path, std::size_t worker_count);
+
+  Server(const Server&) = delete;
+  Server& operator=(const Server&) = delete;
+
+  ~Server() noexcept;
+
+  /// @brief Accepts connections and serves their requests until `Stop` is called.
+  ///
+  /// Running out of descriptors or memory only pauses accepting for a while.
+  /// Throws `SocketError` once the listener fails otherwise, after requests in
+  /// flight are served.
+  void Run();
+
+  /// @brief Makes `Run` return once requests in flight are served.
+  ///
+  /// Accepted connections are shut down for reading, so no new requests are
+  /// taken from them.
+  void Stop() noexcept;
+
+ private:
+  static constexpr std::chrono::milliseconds kAcceptPause{100};
+
+ private:
+  /// @return Zero once pending connections are accepted, `errno` of a failure otherwise.
+  int Accept(std::vector<int>& idle);
+
+  void Wake() noexcept;
+
+  void Work();
+
+  void Release(Connection& connection, bool open);
+
+  /// @return `false` if the peer has closed the connection.
+  bool Serve(Connection& connection);
+
+  void Lex(IReader& reader, std::string_view file_name, std::ostream& stream);
+
+ private:
+  std::string socket_path_;
+  int listener_;
+  int wake_reader_;
+  int wake_writer_;
+  std::size_t worker_count_;
+  KeywordTable keyword_table_;
+  std::vector<std::thread> workers_;
+  std::unordered_map<int, std::unique_ptr<Connection>> connections_;
+  std::queue<Connection*> ready_;
+  std::vector<int> returned_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::atomic<bool> stopped_;
+};
+
+}  // namespace compiler
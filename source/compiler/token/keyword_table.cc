@@ -38,7 +38,7 @@ KeywordTable::KeywordTable()
   keywords_.emplace("while", kWhile);
 }
 
-std::optional<Keyword> KeywordTable::TryFind(const std::string& string) const noexcept {
+std::optional<Keyword> KeywordTable::TryFind(std::string_view string) const noexcept {
   auto iterator = keywords_.find(string);
   if (iterator == keywords_.cend()) {
     return std::nullopt;
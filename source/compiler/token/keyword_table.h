@@ -1,6 +1,7 @@
 #pragma once
 
 #include <optional>
+#include <string_view>
 #include <unordered_map>
 
 #include <compiler/token/token.h>
@@ -11,10 +12,11 @@ class KeywordTable final {
  public:
   KeywordTable();
 
-  std::optional<Keyword> TryFind(const std::string& string) const noexcept;
+  std::optional<Keyword> TryFind(std::string_view string) const noexcept;
 
  private:
-  std::unordered_map<std::string, Keyword> keywords_;
+  // Keys refer to string literals, so lookups by a view into a source do not allocate.
+  std::unordered_map<std::string_view, Keyword> keywords_;
 };
 
 }  // namespace compiler
\ No newline at end of file
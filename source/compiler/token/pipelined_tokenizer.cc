@@ -0,0 +1,108 @@
+#include <utility>
+
+#include <compiler/common/common.h>
+
+#include <compiler/token/pipelined_tokenizer.h>
+#include <compiler/token/tokenizer.h>
+
+namespace compiler {
+
+PipelinedTokenizer::PipelinedTokenizer(IReader& reader, const KeywordTable& keyword_table)
+  : batches_{}
+  , filled_{}
+  , free_{}
+  , current_{nullptr}
+  , pending_error_{}
+  , finished_{false}
+  , producer_{} {
+  for (auto& batch : batches_) {
+    batch.tokens.reserve(kBatchSize);
+    free_.TryPush(&batch);
+  }
+  producer_ = std::thread{[this, &reader, &keyword_table] {
+    Produce(reader, keyword_table);
+  }};
+}
+
+PipelinedTokenizer::~PipelinedTokenizer() noexcept {
+  // Wakes the producer up if it waits for a free batch.
+  free_.Push(nullptr);
+  producer_.join();
+}
+
+std::span<Token> PipelinedTokenizer::Next() {
+  if (current_ != nullptr) {
+    current_->tokens.clear();
+    current_->error = nullptr;
+    bool recycled = free_.TryPush(current_);
+    ASSERT(recycled);
+    (void)recycled;
+    current_ = nullptr;
+  }
+  if (pending_error_) {
+    std::rethrow_exception(std::exchange(pending_error_, nullptr));
+  }
+  if (finished_) {
+    return {};
+  }
+
+  current_ = filled_.Pop();
+  pending_error_ = current_->error;
+  // Only the last batch is not full, either because of the end or of an error.
+  finished_ = current_->tokens.size() < kBatchSize;
+  if (current_->tokens.empty() && pending_error_) {
+    std::rethrow_exception(std::exchange(pending_error_, nullptr));
+  }
+  return current_->tokens;
+}
+
+void PipelinedTokenizer::Produce(IReader& reader, const KeywordTable& keyword_table) {
+  Tokenizer tokenizer{reader, keyword_table};
+
+  while (true) {
+    // A null batch comes from the destructor once the consumer is gone.
+    auto batch = free_.Pop();
+    if (batch == nullptr) {
+      return;
+    }
+
+    bool compilation_unit_found{false};
+    try {
+      while (!compilation_unit_found && batch->tokens.size() < kBatchSize) {
+        batch->tokens.push_back(tokenizer.Tokenize());
+        batch->tokens.back().Match(
+          [&](CompilationUnitEnd) {
+            compilation_unit_found = true;
+          },
+          [](const auto&) {
+          }
+        );
+      }
+    } catch (...) {
+      batch->error = std::current_exception();
+    }
+
+    bool last = compilation_unit_found || batch->error;
+    if (last && batch->tokens.size() == kBatchSize) {
+      // Keeps "a short batch is the last one" true for the consumer.
+      Publish(batch);
+      batch = free_.Pop();
+      if (batch == nullptr) {
+        return;
+      }
+    }
+    Publish(batch);
+    if (last) {
+      return;
+    }
+  }
+}
+
+void PipelinedTokenizer::Publish(TokenBatch* batch) {
+  // There are as many batches as ring slots, so a push always succeeds.
+  bool published = filled_.TryPush(batch);
+  ASSERT(published);
+  (void)published;
+}
+
+}  // namespace compiler
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <exception>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <compiler/common/spsc_ring.h>
+
+#include <compiler/io/reader.h>
+
+#include <compiler/token/keyword_table.h>
+#include <compiler/token/token.h>
+
+namespace compiler {
+
+struct TokenBatch {
+  std::vector<Token> tokens;
+  std::exception_ptr error;
+};
+
+/// @brief Runs `Tokenizer` on a producer thread and hands tokens over to the
+/// consumer thread in fixed-size batches, so lexing overlaps with whatever
+/// the consumer does with tokens.
+///
+/// Batches travel through a pair of lock-free rings: filled ones go to the
+/// consumer, consumed ones come back to the producer for reuse. A fixed
+/// number of batches bounds memory and blocks the producer once the consumer
+/// falls behind, the consumer blocks while no batch is ready.
+class PipelinedTokenizer final {
+ public:
+  static constexpr std::size_t kBatchSize = 256;
+  static constexpr std::size_t kBatchCount = 8;
+
+ public:
+  /// @brief Starts lexing right away, `reader` is only accessed by the producer.
+  PipelinedTokenizer(IReader& reader, const KeywordTable& keyword_table);
+
+  PipelinedTokenizer(const PipelinedTokenizer&) = delete;
+  PipelinedTokenizer& operator=(const PipelinedTokenizer&) = delete;
+
+  /// @brief Stops the producer if the consumer gave up early.
+  ~PipelinedTokenizer() noexcept;
+
+  /// @brief Returns the next batch of tokens and recycles the previous one.
+  ///
+  /// The last non-empty batch ends with the compilation unit end, an empty
+  /// span follows it. A lexing error is rethrown after the tokens lexed
+  /// before it are returned.
+  std::span<Token> Next();
+
+ private:
+  void Produce(IReader& reader, const KeywordTable& keyword_table);
+
+  void Publish(TokenBatch* batch);
+
+ private:
+  std::array<TokenBatch, kBatchCount> batches_;
+  SpscRing<TokenBatch*, kBatchCount> filled_;
+  // Leaves room for the null batch stopping the producer next to all the others.
+  SpscRing<TokenBatch*, 2 * kBatchCount> free_;
+  TokenBatch* current_;
+  std::exception_ptr pending_error_;
+  bool finished_;
+  std::thread producer_;
+};
+
+}  // namespace compiler
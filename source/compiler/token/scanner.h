@@ -0,0 +1,373 @@
+#pragma once
+
+#include <cctype>
+#include <cstddef>
+#include <string_view>
+
+#include <compiler/common/common.h>
+
+#include <compiler/token/keyword_table.h>
+#include <compiler/token/token.h>
+#include <compiler/token/tokenizer.h>
+
+namespace compiler {
+
+/// @brief A push-style lexer driving a visitor instead of materializing tokens.
+///
+/// It accepts the same language as `Tokenizer` and throws the same exceptions,
+/// but scans a contiguous buffer and never allocates. The visitor provides
+///   bool OnKeyword(Keyword keyword, std::string_view span);
+///   bool OnControl(Control control, std::string_view span);
+///   bool OnCharacterLiteral(char character_literal, std::string_view span);
+///   bool OnNumericLiteral(int numeric_literal, std::string_view span);
+///   bool OnStringLiteral(std::string_view span);
+///   bool OnIdentifier(std::string_view span);
+///   void OnCompilationUnitEnd();
+/// Spans point into the scanned source, so a token position is the offset of
+/// its span from the source beginning. The span of a string literal excludes
+/// quotes and keeps escape sequences as written. Returning `false` from any
+/// callback stops the scan.
+template <typename TVisitor>
+class Scanner final {
+ public:
+  Scanner(std::string_view source, const KeywordTable& keyword_table, TVisitor& visitor) noexcept;
+
+  /// @return `true` if the whole source is scanned, `false` if the visitor stopped it.
+  bool Scan();
+
+ private:
+  static bool IsAlphabetic(char character) noexcept;
+
+  static bool IsNumeric(char character) noexcept;
+
+  static bool IsWhitespace(char character) noexcept;
+
+  static bool IsPunctuation(char character) noexcept;
+
+ private:
+  char Peek() const noexcept;
+
+  std::string_view SpanFrom(std::size_t begin) const noexcept;
+
+  bool ScanIdentifierOrKeyword();
+
+  bool ScanControl();
+
+  bool ScanCharacterLiteral();
+
+  bool ScanNumericLiteral();
+
+  bool ScanStringLiteral();
+
+ private:
+  std::string_view source_;
+  std::size_t cursor_;
+  const KeywordTable& keyword_table_;
+  TVisitor& visitor_;
+};
+
+template <typename TVisitor>
+Scanner<TVisitor>::Scanner(std::string_view source,
+                           const KeywordTable& keyword_table,
+                           TVisitor& visitor) noexcept
+  : source_{source}
+  , cursor_{}
+  , keyword_table_{keyword_table}
+  , visitor_{visitor} {
+}
+
+template <typename TVisitor>
+bool Scanner<TVisitor>::Scan() {
+  while (true) {
+    auto character = Peek();
+    while (IsWhitespace(character)) {
+      ++cursor_;
+      character = Peek();
+    }
+
+    bool proceed{};
+    if (character == '\0') {
+      visitor_.OnCompilationUnitEnd();
+      return true;
+    } else if (IsAlphabetic(character) || character == '_') {
+      proceed = ScanIdentifierOrKeyword();
+    } else if (IsPunctuation(character)) {
+      proceed = ScanControl();
+    } else if (character == '\'') {
+      proceed = ScanCharacterLiteral();
+    } else if (IsNumeric(character)) {
+      proceed = ScanNumericLiteral();
+    } else if (character == '\"') {
+      proceed = ScanStringLiteral();
+    } else {
+      throw UnsupportedCharacter{};
+    }
+
+    if (!proceed) {
+      return false;
+    }
+  }
+  UNREACHABLE();
+}
+
+template <typename TVisitor>
+bool Scanner<TVisitor>::IsAlphabetic(char character) noexcept {
+  return std::isalpha(static_cast<unsigned char>(character));
+}
+
+template <typename TVisitor>
+bool Scanner<TVisitor>::IsNumeric(char character) noexcept {
+  return std::isdigit(static_cast<unsigned char>(character));
+}
+
+template <typename TVisitor>
+bool Scanner<TVisitor>::IsWhitespace(char character) noexcept {
+  return std::isspace(static_cast<unsigned char>(character));
+}
+
+template <typename TVisitor>
+bool Scanner<TVisitor>::IsPunctuation(char character) noexcept {
+  return std::ispunct(static_cast<unsigned char>(character)) && character != '$' &&
+                                                                character != '@' &&
+                                                                character != '#' &&
+                                                                character != '"' &&
+                                                                character != '\'';
+}
+
+template <typename TVisitor>
+char Scanner<TVisitor>::Peek() const noexcept {
+  if (cursor_ < source_.size()) {
+    return source_[cursor_];
+  }
+  return '\0';
+}
+
+template <typename TVisitor>
+std::string_view Scanner<TVisitor>::SpanFrom(std::size_t begin) const noexcept {
+  return source_.substr(begin, cursor_ - begin);
+}
+
+template <typename TVisitor>
+bool Scanner<TVisitor>::ScanIdentifierOrKeyword() {
+  auto begin = cursor_;
+  while (IsAlphabetic(Peek()) || Peek() == '_') {
+    ++cursor_;
+  }
+  auto span = SpanFrom(begin);
+  if (auto keyword = keyword_table_.TryFind(span)) {
+    return visitor_.OnKeyword(*keyword, span);
+  }
+  return visitor_.OnIdentifier(span);
+}
+
+template <typename TVisitor>
+bool Scanner<TVisitor>::ScanControl() {
+  auto begin = cursor_;
+  auto control = [&](Control kind, std::size_t size) {
+    cursor_ = begin + size;
+    return visitor_.OnControl(kind, SpanFrom(begin));
+  };
+  auto next = [&](std::size_t offset) {
+    return begin + offset < source_.size() ? source_[begin + offset] : '\0';
+  };
+
+  switch (next(0)) {
+    case '(': {
+      return control(kOpenBracket, 1);
+    }
+    case ')': {
+      return control(kCloseBracket, 1);
+    }
+    case '[': {
+      return control(kOpenSquareBracket, 1);
+    }
+    case ']': {
+      return control(kCloseSquareBracket, 1);
+    }
+    case '{': {
+      return control(kOpenBrace, 1);
+    }
+    case '}': {
+      return control(kCloseBrace, 1);
+    }
+    case '?': {
+      return control(kQuestion, 1);
+    }
+    case '!': {
+      return control(kExclamation, 1);
+    }
+    case '~': {
+      return control(kTilde, 1);
+    }
+    case ':': {
+      return control(kColon, 1);
+    }
+    case ';': {
+      return control(kSemicolon, 1);
+    }
+    case ',': {
+      return control(kComma, 1);
+    }
+    case '.': {
+      if (next(1) != '.') {
+        return control(kPeriod, 1);
+      }
+      if (next(2) != '.') {
+        throw IllFormedControl{};
+      }
+      return control(kElipsis, 3);
+    }
+    case '+': {
+      switch (next(1)) {
+        case '+': {
+          return control(kPlusPlus, 2);
+        }
+        case '=': {
+          return control(kPlusEqual, 2);
+        }
+        default: {
+          return control(kPlus, 1);
+        }
+      }
+    }
+    case '-': {
+      switch (next(1)) {
+        case '-': {
+          return control(kMinusMinus, 2);
+        }
+        case '=': {
+          return control(kMinusEqual, 2);
+        }
+        default: {
+          return control(kMinus, 1);
+        }
+      }
+    }
+    case '&': {
+      switch (next(1)) {
+        case '&': {
+          return control(kAmpersandAmpersand, 2);
+        }
+        case '=': {
+          return control(kAmpersandEqual, 2);
+        }
+        default: {
+          return control(kAmpersand, 1);
+        }
+      }
+    }
+    case '|': {
+      switch (next(1)) {
+        case '|': {
+          return control(kPipePipe, 2);
+        }
+        case '=': {
+          return control(kPipeEqual, 2);
+        }
+        default: {
+          return control(kPipe, 1);
+        }
+      }
+    }
+    case '*': {
+      return next(1) == '=' ? control(kStarEqual, 2) : control(kStar, 1);
+    }
+    case '/': {
+      return next(1) == '=' ? control(kSlashEqual, 2) : control(kSlash, 1);
+    }
+    case '%': {
+      return next(1) == '=' ? control(kPercentEqual, 2) : control(kPercent, 1);
+    }
+    case '=': {
+      return next(1) == '=' ? control(kEqualEqual, 2) : control(kEqual, 1);
+    }
+    case '^': {
+      return next(1) == '=' ? control(kCaretEqual, 2) : control(kCaret, 1);
+    }
+    case '<': {
+      switch (next(1)) {
+        case '<': {
+          return next(2) == '=' ? control(kLessLessEqual, 3) : control(kLessLess, 2);
+        }
+        case '=': {
+          return control(kLessEqual, 2);
+        }
+        default: {
+          return control(kLess, 1);
+        }
+      }
+    }
+    case '>': {
+      switch (next(1)) {
+        case '>': {
+          return next(2) == '=' ? control(kGreaterGreaterEqual, 3) : control(kGreaterGreater, 2);
+        }
+        case '=': {
+          return control(kGreaterEqual, 2);
+        }
+        default: {
+          return control(kGreater, 1);
+        }
+      }
+    }
+    default: {
+      throw UnsupportedCharacter{};
+    }
+  }
+  UNREACHABLE();
+}
+
+template <typename TVisitor>
+bool Scanner<TVisitor>::ScanCharacterLiteral() {
+  ASSERT(Peek() == '\'');
+
+  auto begin = cursor_++;
+  // Mirrors `Tokenizer`: a literal is exactly one character, escapes are not supported.
+  auto character_literal = Peek();
+  if (cursor_ < source_.size()) {
+    ++cursor_;
+  }
+  if (Peek() != '\'') {
+    throw IllFormedCharacterLiteral{};
+  }
+  ++cursor_;
+  return visitor_.OnCharacterLiteral(character_literal, SpanFrom(begin));
+}
+
+template <typename TVisitor>
+bool Scanner<TVisitor>::ScanNumericLiteral() {
+  ASSERT(IsNumeric(Peek()));
+
+  auto begin = cursor_;
+  unsigned numeric_literal{};
+  while (IsNumeric(Peek())) {
+    numeric_literal *= 10;
+    numeric_literal += static_cast<unsigned>(source_[cursor_++] - '0');
+  }
+  return visitor_.OnNumericLiteral(static_cast<int>(numeric_literal), SpanFrom(begin));
+}
+
+template <typename TVisitor>
+bool Scanner<TVisitor>::ScanStringLiteral() {
+  ASSERT(Peek() == '\"');
+
+  auto begin = ++cursor_;
+  while (true) {
+    auto character = Peek();
+    if (character == '\0') {
+      throw IllFormedStringLiteral{};
+    }
+    if (character == '\"') {
+      break;
+    }
+    if (character == '\\' && cursor_ + 1 < source_.size()) {
+      ++cursor_;
+    }
+    ++cursor_;
+  }
+  auto span = SpanFrom(begin);
+  ++cursor_;
+  return visitor_.OnStringLiteral(span);
+}
+
+}  // namespace compiler
@@ -0,0 +1,67 @@
+#include <utility>
+
+#include <compiler/token/token_stream.h>
+#include <compiler/token/tokenizer.h>
+
+namespace compiler {
+
+Generator<Token> GenerateTokens(IReader& reader, const KeywordTable& keyword_table) {
+  Tokenizer tokenizer{reader, keyword_table};
+  bool compilation_unit_found{false};
+  while (!compilation_unit_found) {
+    auto token = tokenizer.Tokenize();
+    token.Match(
+      [&](CompilationUnitEnd) {
+        compilation_unit_found = true;
+      },
+      [](const auto&) {
+      }
+    );
+    co_yield std::move(token);
+  }
+}
+
+TokenStream::TokenStream(Generator<Token> generator)
+  : generator_{std::move(generator)}
+  , slots_(1)
+  , head_{}
+  , size_{} {
+}
+
+Token& TokenStream::Peek(std::size_t k) {
+  Fill(k + 1);
+  return *slots_[(head_ + k) & (slots_.size() - 1)];
+}
+
+Token TokenStream::Consume() {
+  Fill(1);
+  auto token = std::move(*slots_[head_]);
+  slots_[head_].reset();
+  head_ = (head_ + 1) & (slots_.size() - 1);
+  --size_;
+  return token;
+}
+
+void TokenStream::Fill(std::size_t count) {
+  while (size_ < count) {
+    if (size_ == slots_.size()) {
+      Grow();
+    }
+    auto token = generator_.Next();
+    slots_[(head_ + size_) & (slots_.size() - 1)] =
+        token ? std::move(*token) : Token::FromCompilationUnitEnd();
+    ++size_;
+  }
+}
+
+void TokenStream::Grow() {
+  // Capacity stays a power of two, so positions wrap with a mask.
+  std::vector<std::optional<Token>> slots(slots_.size() * 2);
+  for (std::size_t index = 0; index < size_; ++index) {
+    slots[index] = std::move(slots_[(head_ + index) & (slots_.size() - 1)]);
+  }
+  slots_ = std::move(slots);
+  head_ = 0;
+}
+
+}  // namespace compiler
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <compiler/common/generator.h>
+
+#include <compiler/io/reader.h>
+
+#include <compiler/token/keyword_table.h>
+#include <compiler/token/token.h>
+
+namespace compiler {
+
+/// @brief Lexes tokens on demand, the last one is the compilation unit end.
+///
+/// Both `reader` and `keyword_table` have to outlive the generator.
+Generator<Token> GenerateTokens(IReader& reader, const KeywordTable& keyword_table);
+
+/// @brief A token stream with arbitrary lookahead for parsers.
+///
+/// Tokens are pulled from the generator only when looked at and kept in a
+/// ring buffer until consumed, so memory is bounded by the deepest lookahead
+/// used rather than by the compilation unit size. Past the end the stream
+/// keeps returning the compilation unit end.
+class TokenStream final {
+ public:
+  TokenStream(Generator<Token> generator);
+
+  /// @brief Returns the `k`-th token ahead without consuming it, `Peek(0)`
+  /// is the next token. Amortized O(1).
+  ///
+  /// The reference points into the ring buffer and is valid only until the
+  /// next call to `Peek` or `Consume`, which may grow or reuse the slot.
+  Token& Peek(std::size_t k = 0);
+
+  /// @brief Removes the next token from the stream and returns it.
+  Token Consume();
+
+ private:
+  void Fill(std::size_t count);
+
+  void Grow();
+
+ private:
+  Generator<Token> generator_;
+  std::vector<std::optional<Token>> slots_;
+  std::size_t head_;
+  std::size_t size_;
+};
+
+}  // namespace compiler
@@ -0,0 +1,73 @@
+#include <compiler/token/token_writer.h>
+
+namespace compiler::detail {
+
+/// @return `false` if the token is the compilation unit end.
+bool WriteToken(Token& token, std::ostream& stream) {
+  bool compilation_unit_found{false};
+  token.Match(
+    [&](CompilationUnitEnd) {
+      compilation_unit_found = true;
+    },
+    [&](Keyword keyword) {
+      stream << "keyword: " << keyword << '\n';
+    },
+    [&](Control control) {
+      stream << "control: " << control << '\n';
+    },
+    [&](CharacterLiteral literal) {
+      stream << "character literal: '" << literal.value << "'" << '\n';
+    },
+    [&](NumericLiteral literal) {
+      stream << "numeric literal: " << literal.value << '\n';
+    },
+    [&](const StringLiteral& literal) {
+      stream << "string literal: '" << literal.value << "'" << '\n';
+    },
+    [&](const Identifier& identifier) {
+      stream << "identifier: '" << identifier.value << "'" << '\n';
+    }
+  );
+  return !compilation_unit_found;
+}
+
+}  // namespace compiler::detail
+
+namespace compiler {
+
+std::size_t WriteTokens(Tokenizer& tokenizer, std::ostream& stream) {
+  std::size_t token_count{};
+  while (true) {
+    auto token = tokenizer.Tokenize();
+    if (!detail::WriteToken(token, stream)) {
+      return token_count;
+    }
+    ++token_count;
+  }
+}
+
+std::size_t WriteTokens(PipelinedTokenizer& tokenizer, std::ostream& stream) {
+  std::size_t token_count{};
+  for (auto tokens = tokenizer.Next(); !tokens.empty(); tokens = tokenizer.Next()) {
+    for (auto& token : tokens) {
+      if (!detail::WriteToken(token, stream)) {
+        return token_count;
+      }
+      ++token_count;
+    }
+  }
+  return token_count;
+}
+
+std::size_t WriteTokens(TokenStream& stream, std::ostream& output) {
+  std::size_t token_count{};
+  while (true) {
+    auto token = stream.Consume();
+    if (!detail::WriteToken(token, output)) {
+      return token_count;
+    }
+    ++token_count;
+  }
+}
+
+}  // namespace compiler
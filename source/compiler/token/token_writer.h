@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+
+#include <compiler/token/pipelined_tokenizer.h>
+#include <compiler/token/token_stream.h>
+#include <compiler/token/tokenizer.h>
+
+namespace compiler {
+
+/// @brief Tokenizes the whole compilation unit and writes one line per token.
+///
+/// @return The number of written tokens, compilation unit end excluded.
+std::size_t WriteTokens(Tokenizer& tokenizer, std::ostream& stream);
+
+/// @brief Same as above, but tokens are lexed on a producer thread.
+std::size_t WriteTokens(PipelinedTokenizer& tokenizer, std::ostream& stream);
+
+/// @brief Same as above, but tokens are pulled from a lazy token stream.
+std::size_t WriteTokens(TokenStream& stream, std::ostream& output);
+
+}  // namespace compiler
@@ -7,23 +7,23 @@
 namespace compiler::detail {
 
 bool IsAlphabetic(char character) noexcept {
-  return std::isalpha(character);
+  return std::isalpha(static_cast<unsigned char>(character));
 }
 
 bool IsNumeric(char character) noexcept {
-  return std::isdigit(character);
+  return std::isdigit(static_cast<unsigned char>(character));
 }
 
 bool IsWhitespace(char character) noexcept {
-  return std::isspace(character);
+  return std::isspace(static_cast<unsigned char>(character));
 }
 
 bool IsPunctuation(char character) noexcept {
-  return std::ispunct(character) && character != '$' &&
-                                    character != '@' &&
-                                    character != '#' &&
-                                    character != '"' &&
-                                    character != '\'';
+  return std::ispunct(static_cast<unsigned char>(character)) && character != '$' &&
+                                                                character != '@' &&
+                                                                character != '#' &&
+                                                                character != '"' &&
+                                                                character != '\'';
 }
 
 bool IsQuotation(char character) noexcept {
@@ -46,6 +46,11 @@ bool IsUnderscore(char character) noexcept {
   return character == '_';
 }
 
+const KeywordTable& DefaultKeywordTable() {
+  static const KeywordTable keyword_table{};
+  return keyword_table;
+}
+
 }  // namespace compiler::detail
 
 namespace compiler {
@@ -54,6 +59,10 @@ const char* UnsupportedCharacter::what() const noexcept {
   return "read unsupported character";
 }
 
+const char* IllFormedControl::what() const noexcept {
+  return "ill-formed control";
+}
+
 const char* IllFormedCharacterLiteral::what() const noexcept {
   return "ill-formed character literal";
 }
@@ -67,8 +76,12 @@ const char* IllFormedStringLiteral::what() const noexcept {
 }
 
 Tokenizer::Tokenizer(IReader& reader) noexcept
+  : Tokenizer{reader, detail::DefaultKeywordTable()} {
+}
+
+Tokenizer::Tokenizer(IReader& reader, const KeywordTable& keyword_table) noexcept
   : reader_{reader}
-  , keyword_table_{} {
+  , keyword_table_{keyword_table} {
 }
 
 Token Tokenizer::Tokenize() {
@@ -161,13 +174,12 @@ Token Tokenizer::ParseControl() {
       if (reader_.Peek() == '.') {
         reader_.Advance();
         if (reader_.Peek() == '.') {
+          reader_.Advance();
           return Token::FromControl(kElipsis);
-        } else {
-          // TODO(elisfromkirov): Throw an exception `ill-formed control`
         }
-      } else {
-        return Token::FromControl(kPeriod);
+        throw IllFormedControl{};
       }
+      return Token::FromControl(kPeriod);
     }
     case '+': {
       switch (reader_.Peek()) {
@@ -273,6 +285,17 @@ Token Tokenizer::ParseControl() {
         }
       }
     }
+    case '^': {
+      switch (reader_.Peek()) {
+        case '=': {
+          reader_.Advance();
+          return Token::FromControl(kCaretEqual);
+        }
+        default: {
+          return Token::FromControl(kCaret);
+        }
+      }
+    }
     case '<': {
       switch (reader_.Peek()) {
         case '<': {
@@ -319,33 +342,40 @@ Token Tokenizer::ParseControl() {
         }
       }
     }
+    default: {
+      throw UnsupportedCharacter{};
+    }
   }
   UNREACHABLE();
 }
 
 Token Tokenizer::ParseCharacterLiteral() {
-  ASSERT(detail::IsQuotation(reader_.Read()));
+  ASSERT(detail::IsQuotation(reader_.Peek()));
+  reader_.Advance();
 
   char character_literal = reader_.Read();
   if (!detail::IsQuotation(reader_.Peek())) {
     throw IllFormedCharacterLiteral{};
   }
+  reader_.Advance();
   return Token::FromCharacterLiteral(character_literal);
 }
 
 Token Tokenizer::ParseNumericLiteral() {
-  ASSERT(detail::IsNumeric(reader_.Read()));
+  ASSERT(detail::IsNumeric(reader_.Peek()));
 
-  int value{};
+  // Overflowing literals wrap around instead of overflowing a signed integer.
+  unsigned value{};
   while (detail::IsNumeric(reader_.Peek())) {
     value *= 10;
-    value += static_cast<int>(reader_.Read()) - static_cast<int>('0');
+    value += static_cast<unsigned>(reader_.Read() - '0');
   }
-  return Token::FromNumericLiteral(value);
+  return Token::FromNumericLiteral(static_cast<int>(value));
 }
 
 Token Tokenizer::ParseStringLiteral() {
-  ASSERT(detail::IsDoubleQuotation(reader_.Read()));
+  ASSERT(detail::IsDoubleQuotation(reader_.Peek()));
+  reader_.Advance();
 
   std::string string_literal{};
   while (true) {
@@ -354,6 +384,7 @@ Token Tokenizer::ParseStringLiteral() {
       throw IllFormedStringLiteral{};
     }
     if (detail::IsDoubleQuotation(character)) {
+      reader_.Advance();
       break;
     }
     if (detail::IsEscape(character)) {
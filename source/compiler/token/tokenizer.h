@@ -14,6 +14,11 @@ class UnsupportedCharacter final : public std::exception {
   const char* what() const noexcept override;
 };
 
+class IllFormedControl final : public std::exception {
+ public:
+  const char* what() const noexcept override;
+};
+
 class IllFormedCharacterLiteral final : public std::exception {
  public:
   const char* what() const noexcept override;
@@ -33,6 +38,10 @@ class Tokenizer final {
  public:
   Tokenizer(IReader& reader) noexcept;
 
+  /// @brief Creates a tokenizer sharing an already built keyword table, so
+  /// long-lived callers do not rebuild it for every compilation unit.
+  Tokenizer(IReader& reader, const KeywordTable& keyword_table) noexcept;
+
   Token Tokenize();
 
  private:
@@ -50,7 +59,7 @@ class Tokenizer final {
 
  private:
   IReader& reader_;
-  KeywordTable keyword_table_;
+  const KeywordTable& keyword_table_;
 };
 
 }  // namespace compiler
\ No newline at end of file
@@ -0,0 +1,253 @@
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <unistd.h>
+
+#include <compiler/trace/trace.h>
+
+namespace compiler::detail {
+
+constexpr std::size_t kUnsetCount = static_cast<std::size_t>(-1);
+
+/// The newest spans a thread keeps, older ones are overwritten.
+constexpr std::size_t kEventCapacity = 64 * 1024;
+
+struct TraceEvent {
+  const char* name;
+  std::uint32_t file_index;
+  std::chrono::steady_clock::time_point begin;
+  std::chrono::steady_clock::time_point end;
+  std::size_t byte_count;
+  std::size_t token_count;
+};
+
+struct StringHash {
+  using is_transparent = void;
+
+  std::size_t operator()(std::string_view string) const noexcept {
+    return std::hash<std::string_view>{}(string);
+  }
+};
+
+/// @brief Spans of a single thread in a ring of `kEventCapacity` events, file
+/// names are interned so recording a span does not allocate.
+///
+/// Only the owning thread touches it until `WriteTrace`, which runs after the
+/// recording threads are joined.
+struct ThreadTrace {
+  std::uint32_t thread_id{};
+  std::vector<TraceEvent> events{};
+  std::size_t recorded_count{};
+  std::vector<std::string> file_names{};
+  std::unordered_map<std::string, std::uint32_t, StringHash, std::equal_to<>> file_indices{};
+
+  void Record(const TraceEvent& event);
+
+  std::uint32_t Intern(std::string_view file_name);
+
+  /// @brief Drops file names no kept span refers to, except the slot about to be overwritten.
+  void CompactFileNames();
+
+  template <typename TVisitor>
+  void ForEachEvent(TVisitor&& visitor) const {
+    auto first = recorded_count > events.size() ? recorded_count % events.size() : 0;
+    for (std::size_t offset = 0; offset < events.size(); ++offset) {
+      visitor(events[(first + offset) % events.size()]);
+    }
+  }
+};
+
+void ThreadTrace::Record(const TraceEvent& event) {
+  if (events.size() < kEventCapacity) {
+    events.push_back(event);
+  } else {
+    events[recorded_count % kEventCapacity] = event;
+  }
+  ++recorded_count;
+}
+
+std::uint32_t ThreadTrace::Intern(std::string_view file_name) {
+  // Consecutive spans mostly belong to the same file.
+  if (!file_names.empty() && file_names.back() == file_name) {
+    return static_cast<std::uint32_t>(file_names.size() - 1);
+  }
+  if (auto found = file_indices.find(file_name); found != file_indices.end()) {
+    return found->second;
+  }
+  // Twice as many names as spans, so a compaction frees at least half of them.
+  if (file_names.size() == 2 * kEventCapacity) {
+    CompactFileNames();
+  }
+  auto index = static_cast<std::uint32_t>(file_names.size());
+  file_names.emplace_back(file_name);
+  file_indices.emplace(file_names.back(), index);
+  return index;
+}
+
+void ThreadTrace::CompactFileNames() {
+  constexpr auto kDropped = static_cast<std::uint32_t>(-1);
+
+  std::vector<std::uint32_t> remapped(file_names.size(), kDropped);
+  std::vector<std::string> kept_names{};
+  for (std::size_t slot = 0; slot < events.size(); ++slot) {
+    if (events.size() == kEventCapacity && slot == recorded_count % kEventCapacity) {
+      continue;
+    }
+    auto& index = events[slot].file_index;
+    if (remapped[index] == kDropped) {
+      remapped[index] = static_cast<std::uint32_t>(kept_names.size());
+      kept_names.push_back(std::move(file_names[index]));
+    }
+    index = remapped[index];
+  }
+
+  file_names = std::move(kept_names);
+  file_indices.clear();
+  for (std::size_t index = 0; index < file_names.size(); ++index) {
+    file_indices.emplace(file_names[index], static_cast<std::uint32_t>(index));
+  }
+}
+
+/// @brief Owns buffers of all threads, so events survive threads recorded them.
+struct TraceRegistry {
+  std::atomic<bool> enabled{false};
+  std::chrono::steady_clock::time_point epoch{std::chrono::steady_clock::now()};
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadTrace>> threads;
+};
+
+TraceRegistry& GetTraceRegistry() {
+  static TraceRegistry registry{};
+  return registry;
+}
+
+ThreadTrace& GetThreadTrace() {
+  thread_local std::shared_ptr<ThreadTrace> thread_trace = [] {
+    auto& registry = GetTraceRegistry();
+    std::lock_guard guard{registry.mutex};
+    auto thread_trace = std::make_shared<ThreadTrace>();
+    thread_trace->thread_id = static_cast<std::uint32_t>(registry.threads.size() + 1);
+    registry.threads.push_back(thread_trace);
+    return thread_trace;
+  }();
+  return *thread_trace;
+}
+
+void WriteJsonString(std::ostream& stream, std::string_view string) {
+  stream << '"';
+  for (auto character : string) {
+    switch (character) {
+      case '"': {
+        stream << "\\\"";
+        break;
+      }
+      case '\\': {
+        stream << "\\\\";
+        break;
+      }
+      default: {
+        if (static_cast<unsigned char>(character) < 0x20) {
+          stream << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                 << static_cast<int>(character) << std::dec << std::setfill(' ');
+        } else {
+          stream << character;
+        }
+      }
+    }
+  }
+  stream << '"';
+}
+
+double ToMicroseconds(std::chrono::steady_clock::duration duration) {
+  return std::chrono::duration<double, std::micro>{duration}.count();
+}
+
+}  // namespace compiler::detail
+
+namespace compiler {
+
+void EnableTracing() noexcept {
+  detail::GetTraceRegistry().enabled.store(true, std::memory_order_relaxed);
+}
+
+bool IsTracingEnabled() noexcept {
+  return detail::GetTraceRegistry().enabled.load(std::memory_order_relaxed);
+}
+
+void WriteTrace(std::ostream& stream) {
+  auto& registry = detail::GetTraceRegistry();
+  std::lock_guard guard{registry.mutex};
+
+  auto process_id = ::getpid();
+  bool first{true};
+  std::size_t dropped_count{};
+  stream << std::fixed << std::setprecision(3) << "{\"traceEvents\":[\n";
+  for (auto& thread_trace : registry.threads) {
+    dropped_count += thread_trace->recorded_count - thread_trace->events.size();
+    thread_trace->ForEachEvent([&](const detail::TraceEvent& event) {
+      if (!first) {
+        stream << ",\n";
+      }
+      first = false;
+      stream << "{\"name\":\"" << event.name << "\",\"ph\":\"X\""
+             << ",\"pid\":" << process_id
+             << ",\"tid\":" << thread_trace->thread_id
+             << ",\"ts\":" << detail::ToMicroseconds(event.begin - registry.epoch)
+             << ",\"dur\":" << detail::ToMicroseconds(event.end - event.begin)
+             << ",\"args\":{\"file\":";
+      detail::WriteJsonString(stream, thread_trace->file_names[event.file_index]);
+      if (event.byte_count != detail::kUnsetCount) {
+        stream << ",\"bytes\":" << event.byte_count;
+      }
+      if (event.token_count != detail::kUnsetCount) {
+        stream << ",\"tokens\":" << event.token_count;
+      }
+      stream << "}}";
+    });
+  }
+  stream << "\n],\"displayTimeUnit\":\"ms\""
+         << ",\"otherData\":{\"dropped_spans\":" << dropped_count << "}}\n";
+}
+
+TraceScope::TraceScope(const char* name, std::string_view file_name) noexcept
+  : enabled_{IsTracingEnabled()}
+  , name_{name}
+  , file_name_{file_name}
+  , begin_{}
+  , byte_count_{detail::kUnsetCount}
+  , token_count_{detail::kUnsetCount} {
+  if (enabled_) {
+    begin_ = std::chrono::steady_clock::now();
+  }
+}
+
+TraceScope::~TraceScope() noexcept {
+  if (!enabled_) {
+    return;
+  }
+  auto end = std::chrono::steady_clock::now();
+  try {
+    auto& thread_trace = detail::GetThreadTrace();
+    thread_trace.Record(detail::TraceEvent{
+      name_, thread_trace.Intern(file_name_), begin_, end, byte_count_, token_count_});
+  } catch (...) {
+    // Losing a span is better than terminating a traced run.
+  }
+}
+
+void TraceScope::SetByteCount(std::size_t byte_count) noexcept {
+  byte_count_ = byte_count;
+}
+
+void TraceScope::SetTokenCount(std::size_t token_count) noexcept {
+  token_count_ = token_count;
+}
+
+}  // namespace compiler
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+
+namespace compiler {
+
+/// @brief Turns on recording of `TraceScope` spans, off by default.
+void EnableTracing() noexcept;
+
+bool IsTracingEnabled() noexcept;
+
+/// @brief Writes spans recorded by all threads so far as Chrome trace-event
+/// JSON, which both chrome://tracing and Perfetto open.
+///
+/// Threads that recorded spans have to be joined or otherwise done recording.
+/// Each thread keeps only its newest spans, the number of overwritten ones is
+/// written as "dropped_spans".
+void WriteTrace(std::ostream& stream);
+
+/// @brief Records a span from construction to destruction into a bounded
+/// buffer of the calling thread. While tracing is disabled it only checks a
+/// flag, while enabled it neither locks nor allocates in the common case.
+class TraceScope final {
+ public:
+  /// @param name A string literal naming the phase, e.g. "lex".
+  /// @param file_name A name of the processed file, has to outlive the scope.
+  TraceScope(const char* name, std::string_view file_name = {}) noexcept;
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+  ~TraceScope() noexcept;
+
+  void SetByteCount(std::size_t byte_count) noexcept;
+
+  void SetTokenCount(std::size_t token_count) noexcept;
+
+ private:
+  bool enabled_;
+  const char* name_;
+  std::string_view file_name_;
+  std::chrono::steady_clock::time_point begin_;
+  std::size_t byte_count_;
+  std::size_t token_count_;
+};
+
+}  // namespace compiler
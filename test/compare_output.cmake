@@ -0,0 +1,16 @@
+# Runs `compiler.out --parse` on COMPILER_INPUT and compares its output with EXPECTED_OUTPUT.
+execute_process(
+    COMMAND ${COMPILER_BINARY} --parse ${COMPILER_INPUT}
+    OUTPUT_VARIABLE actual_output
+    RESULT_VARIABLE result
+    )
+
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "compiler.out exited with ${result}")
+endif()
+
+file(READ ${EXPECTED_OUTPUT} expected_output)
+
+if(NOT actual_output STREQUAL expected_output)
+    message(FATAL_ERROR "output differs from ${EXPECTED_OUTPUT}:\n${actual_output}")
+endif()
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include <compiler/ast/ast.h>
+#include <compiler/ast/ast_writer.h>
+#include <compiler/ast/parser.h>
+
+#include <compiler/io/source_buffer.h>
+
+#include <compiler/token/keyword_table.h>
+#include <compiler/token/token.h>
+#include <compiler/token/token_stream.h>
+
+namespace {
+
+std::string Parse(std::string_view source) {
+  compiler::KeywordTable keyword_table{};
+  compiler::SourceBuffer source_buffer{source};
+  compiler::TokenStream stream{compiler::GenerateTokens(source_buffer, keyword_table)};
+
+  compiler::Ast ast{};
+  compiler::Parser parser{stream, ast};
+  auto root = parser.ParseTranslationUnit();
+
+  std::ostringstream output{};
+  compiler::WriteAst(ast, root, output);
+  return output.str();
+}
+
+/// Parses `expression` as a returned value and writes its tree without indentation
+/// of the enclosing function.
+std::string ParseReturnedExpression(const std::string& expression) {
+  static constexpr std::string_view kReturnStatement = "      return statement\n";
+  static constexpr std::size_t kIndentation = 8;
+
+  auto tree = Parse("int main() { return " + expression + "; }");
+  auto begin = tree.find(kReturnStatement);
+  if (begin == std::string::npos) {
+    return tree;
+  }
+
+  std::istringstream lines{tree.substr(begin + kReturnStatement.size())};
+  std::string result{};
+  std::string line{};
+  while (std::getline(lines, line)) {
+    result += line.substr(std::min(kIndentation, line.size()));
+    result += '\n';
+  }
+  return result;
+}
+
+std::string DescribeControl(compiler::Control control) {
+  return "control " + std::to_string(static_cast<int>(control));
+}
+
+}  // namespace
+
+TEST(ParserTest, BindsMultiplicationTighterThanAddition) {
+  EXPECT_EQ(ParseReturnedExpression("a + b * c"),
+            "binary expression: " + DescribeControl(compiler::kPlus) + "\n"
+            "  identifier: 'a'\n"
+            "  binary expression: " + DescribeControl(compiler::kStar) + "\n"
+            "    identifier: 'b'\n"
+            "    identifier: 'c'\n");
+}
+
+TEST(ParserTest, ParsesBinaryOperatorsLeftAssociative) {
+  EXPECT_EQ(ParseReturnedExpression("a - b - c"),
+            "binary expression: " + DescribeControl(compiler::kMinus) + "\n"
+            "  binary expression: " + DescribeControl(compiler::kMinus) + "\n"
+            "    identifier: 'a'\n"
+            "    identifier: 'b'\n"
+            "  identifier: 'c'\n");
+}
+
+TEST(ParserTest, ParsesAssignmentsRightAssociative) {
+  EXPECT_EQ(ParseReturnedExpression("a = b += c"),
+            "assignment expression: " + DescribeControl(compiler::kEqual) + "\n"
+            "  identifier: 'a'\n"
+            "  assignment expression: " + DescribeControl(compiler::kPlusEqual) + "\n"
+            "    identifier: 'b'\n"
+            "    identifier: 'c'\n");
+}
+
+TEST(ParserTest, OverridesPrecedenceWithParentheses) {
+  EXPECT_EQ(ParseReturnedExpression("(a + b) * c"),
+            "binary expression: " + DescribeControl(compiler::kStar) + "\n"
+            "  binary expression: " + DescribeControl(compiler::kPlus) + "\n"
+            "    identifier: 'a'\n"
+            "    identifier: 'b'\n"
+            "  identifier: 'c'\n");
+}
+
+TEST(ParserTest, BindsPostfixTighterThanUnary) {
+  EXPECT_EQ(ParseReturnedExpression("-a++"),
+            "unary expression: " + DescribeControl(compiler::kMinus) + "\n"
+            "  postfix expression: " + DescribeControl(compiler::kPlusPlus) + "\n"
+            "    identifier: 'a'\n");
+}
+
+TEST(ParserTest, ParsesCallsAndSubscripts) {
+  EXPECT_EQ(ParseReturnedExpression("f(a, 1)[2]"),
+            "subscript expression\n"
+            "  call expression\n"
+            "    identifier: 'f'\n"
+            "    identifier: 'a'\n"
+            "    numeric literal: 1\n"
+            "  numeric literal: 2\n");
+}
+
+TEST(ParserTest, BindsElseToNearestIf) {
+  auto tree = Parse("int main() { if (a) if (b) return 1; else return 2; }");
+  EXPECT_NE(tree.find("      if statement\n"
+                      "        identifier: 'a'\n"
+                      "        if statement\n"
+                      "          identifier: 'b'\n"
+                      "          return statement\n"
+                      "            numeric literal: 1\n"
+                      "          return statement\n"
+                      "            numeric literal: 2\n"),
+            std::string::npos)
+    << tree;
+}
+
+TEST(ParserTest, ParsesGlobalDeclarations) {
+  auto tree = Parse("int a = 1; int main() { return a; }");
+  EXPECT_EQ(tree.substr(0, tree.find("  function definition")),
+            "translation unit\n"
+            "  declaration: type " + std::to_string(static_cast<int>(compiler::kInt)) + "\n"
+            "    declarator: 'a'\n"
+            "      numeric literal: 1\n");
+}
+
+TEST(ParserTest, ParsesLongElseIfChains) {
+  std::string source{"int main() { if (a) return 0;"};
+  for (std::size_t index = 0; index < 2 * compiler::Parser::kMaxNestingDepth; ++index) {
+    source += " else if (a) return 0;";
+  }
+  source += " else return 1; }";
+  EXPECT_NO_THROW(Parse(source));
+}
+
+TEST(ParserTest, RejectsTooDeepNesting) {
+  std::string expression(compiler::Parser::kMaxNestingDepth, '(');
+  expression += 'a';
+  expression += std::string(compiler::Parser::kMaxNestingDepth, ')');
+  EXPECT_THROW(ParseReturnedExpression(expression), compiler::NestingTooDeep);
+}
+
+TEST(ParserTest, RejectsUnexpectedTokens) {
+  EXPECT_THROW(Parse("int main( { }"), compiler::UnexpectedToken);
+  EXPECT_THROW(Parse("int main() { return a +; }"), compiler::UnexpectedToken);
+}